@@ -0,0 +1,124 @@
+//
+//  PythonAggregator.swift
+//
+//
+//  Created by strictlyswift on 17-Oct-26.
+//
+
+import PythonKit
+import libpylamsupport
+
+/// Aggregates a column group by group with a Swift function over each group's values, in place of
+/// `groupby(keys).agg(𝝺{(g:PythonObject) in ...})`, which creates a Series for every group.
+///
+/// The keys are factorised once into group codes, the values partitioned by group into one contiguous array, and
+/// the function called on each group's slice of it.
+///
+/// - Example:
+///
+///       let median = PythonAggregator { values in values.sorted()[values.count / 2] }
+///       let medians = median.aggregate(df.price, by: df.region)   // a Series indexed by region
+///
+/// Like `groupby`, groups are sorted by key, and rows with a missing key are left out. The function runs with the
+/// GIL released, so must not use any `PythonObject`s.
+public struct PythonAggregator {
+    private let fn: (UnsafeBufferPointer<Double>) -> Double
+    private let parallel: Bool
+
+    /// - Parameters:
+    ///   - parallel: whether to aggregate different groups concurrently, across all cores, in which case `fn` must
+    ///     be safe to call from several threads at once
+    ///   - fn: the aggregation, called once per group with the group's values
+    public init(parallel: Bool = false, _ fn: @escaping (UnsafeBufferPointer<Double>) -> Double) {
+        self.fn = fn
+        self.parallel = parallel
+    }
+
+    /// Aggregates `values` grouped by `keys` (array-likes of the same length), returning a pandas Series of the
+    /// results indexed by key
+    public func aggregate(_ values: PythonObject, by keys: PythonObject) -> PythonObject {
+        let groups = PythonGroups(keys)
+        let column = PythonBuffer.requireColumn(values, of: Double.self)
+        let source = column.buffer
+        defer { source.release() }
+        precondition(source.count == groups.rowCount, "values and keys must be the same length")
+
+        let result = PythonNumpy.empty(groups.count, of: Double.self)
+        let target = PythonBuffer.output(result, of: Double.self, count: groups.count)!
+        defer { target.release() }
+
+        withExtendedLifetime(column.owner) {
+            PythonGIL.withoutGIL {
+                let partition = groups.partition(source, of: Double.self)
+                partition.values.withUnsafeBufferPointer { grouped in
+                    let aggregateGroups = { (range: Range<Int>) in
+                        for g in range {
+                            let slice = UnsafeBufferPointer(rebasing: grouped[partition.offsets[g]..<partition.offsets[g + 1]])
+                            target.store(fn(slice), at: g)
+                        }
+                    }
+                    if parallel {
+                        PythonParallel.forEachRange(groups.count, aggregateGroups)
+                    } else {
+                        aggregateGroups(0..<groups.count)
+                    }
+                }
+            }
+        }
+
+        return groups.series(result, name: values.checking.name ?? Python.None)
+    }
+}
+
+/// The groups of a key column: the keys factorised into sorted unique keys, and a group code for every row
+/// (-1 where the key is missing).
+internal final class PythonGroups {
+    let uniques: PythonObject
+    /// The number of groups
+    let count: Int
+    let codes: [Int]
+    private let keyName: PythonObject
+
+    var rowCount: Int { codes.count }
+
+    /// Must be called holding the GIL
+    init(_ keys: PythonObject) {
+        let factorized = PythonPandas.pandas.factorize(keys, sort: true)
+        uniques = factorized[1]
+        count = Int(Python.len(uniques))!
+        keyName = keys.checking.name ?? Python.None
+
+        let codeColumn = PythonBuffer.requireColumn(factorized[0], of: Int.self)
+        defer { codeColumn.buffer.release() }
+        codes = (0..<codeColumn.buffer.count).map { codeColumn.buffer.load($0, as: Int.self) }
+    }
+
+    /// The values of `column` (one per row), partitioned by group with a counting sort: group `g`'s values, in
+    /// their original order, are `values[offsets[g]..<offsets[g + 1]]`. Can be called without the GIL.
+    func partition<T: PythonBufferElement>(_ column: PythonBuffer, of: T.Type) -> (values: [T], offsets: [Int]) {
+        let groupCount = count
+        var offsets = [Int](repeating: 0, count: groupCount + 1)
+        for code in codes where code >= 0 {
+            offsets[code + 1] += 1
+        }
+        for g in 0..<groupCount {
+            offsets[g + 1] += offsets[g]
+        }
+
+        var next = offsets
+        let values = [T](unsafeUninitializedCapacity: offsets[groupCount]) { grouped, initialised in
+            for (row, code) in codes.enumerated() where code >= 0 {
+                (grouped.baseAddress! + next[code]).initialize(to: column.load(row, as: T.self))
+                next[code] += 1
+            }
+            initialised = offsets[groupCount]
+        }
+        return (values, offsets)
+    }
+
+    /// A pandas Series of per-group results, indexed by key. Must be called holding the GIL.
+    func series(_ results: PythonObject, name: PythonObject) -> PythonObject {
+        let index = PythonPandas.pandas.Index(uniques, name: keyName)
+        return PythonPandas.pandas.Series(results, index: index, name: name)
+    }
+}
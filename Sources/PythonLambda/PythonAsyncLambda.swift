@@ -0,0 +1,125 @@
+//
+//  PythonAsyncLambda.swift
+//
+//
+//  Created by strictlyswift on 17-Oct-26.
+//
+
+#if compiler(>=5.5) && canImport(_Concurrency)
+import PythonKit
+import libpylamsupport
+
+@available(macOS 10.15, iOS 13.0, watchOS 6.0, tvOS 13.0, *)
+extension PythonLambda {
+
+    /// Creates a lambda from an `async` Swift function taking an `Int`.
+    ///
+    /// Calling the lambda from Python does not run the function to completion: it returns an `asyncio.Future`
+    /// on the running event loop, which is resolved once the Swift function finishes. The interpreter thread is
+    /// never blocked, so many calls can be in flight at once.
+    ///
+    /// - Example:
+    ///
+    ///       let lookup = 𝝺(awaiting: { (id: Int) in await cache.value(for: id) })
+    ///       // in Python: results = await asyncio.gather(*[lookup(i) for i in ids])
+    ///
+    /// - Note: the lambda must be called from a coroutine running on an asyncio event loop. The function runs
+    /// without the GIL, so it must not create or use any `PythonObject`s; its result is converted to Python once
+    /// the GIL has been re-acquired.
+    public convenience init<R: PythonConvertible>( awaiting fn: @escaping (Int) async -> R) {
+        let name = "lmb\(PythonLambda.lambdaUniqueName())"
+
+        let pfn = { (i: Int) in
+            PythonAwaitable.future { await fn(i) }?.asUnsafePointer
+        }
+
+        self.init(backend: PythonLambdaSupport(pfn, name: name))
+    }
+
+    /// Creates a lambda from an `async` Swift function taking a `Double`. Calling the lambda from Python returns
+    /// an `asyncio.Future` which is resolved once the Swift function finishes.
+    ///
+    /// - See Also: `init(awaiting:)` for `Int` arguments, which describes the restrictions on the function.
+    public convenience init<R: PythonConvertible>( awaiting fn: @escaping (Double) async -> R) {
+        let name = "lmb\(PythonLambda.lambdaUniqueName())"
+
+        let pfn = { (d: Double) in
+            PythonAwaitable.future { await fn(d) }?.asUnsafePointer
+        }
+
+        self.init(backend: PythonLambdaSupport(pfn, name: name))
+    }
+
+    /// Creates a lambda from an `async` Swift function taking a `String`. Calling the lambda from Python returns
+    /// an `asyncio.Future` which is resolved once the Swift function finishes.
+    ///
+    /// - See Also: `init(awaiting:)` for `Int` arguments, which describes the restrictions on the function.
+    public convenience init<R: PythonConvertible>( awaiting fn: @escaping (String) async -> R) {
+        let name = "lmb\(PythonLambda.lambdaUniqueName())"
+
+        let pfn = { (s: String) in
+            PythonAwaitable.future { await fn(s) }?.asUnsafePointer
+        }
+
+        self.init(backend: PythonLambdaSupport(pfn, name: name))
+    }
+}
+
+/// Bridges Swift `async` work onto the running asyncio event loop.
+@available(macOS 10.15, iOS 13.0, watchOS 6.0, tvOS 13.0, *)
+internal enum PythonAwaitable {
+    private static let asyncio = Python.import("asyncio")
+
+    // set_result raises if the awaiting coroutine has been cancelled in the meantime, so check first
+    private static let resolve: PythonObject = {
+        let namespace = Python.dict()
+        Python.exec("""
+        def resolve(future, value):
+            if not future.cancelled():
+                future.set_result(value)
+        """, namespace)
+        return namespace["resolve"]
+    }()
+
+    /// Creates a future on the running event loop, and starts `work` as a detached task which resolves it.
+    /// Must be called holding the GIL. Returns nil, with a Python `RuntimeError` set, if no event loop is running.
+    static func future<T: PythonConvertible>(_ work: @escaping () async -> T) -> PythonObject? {
+        guard let loop = try? asyncio.get_running_loop.throwing.dynamicallyCall(withArguments: []) else {
+            raisePythonError("PyExc_RuntimeError", "async Swift lambdas must be called from a running asyncio event loop")
+            return nil
+        }
+
+        let pending = PendingFuture(loop: loop, future: loop.create_future())
+        Task.detached {
+            let result = await work()
+            PythonGIL.withGIL {
+                pending.resolve(with: result.pythonObject)
+            }
+        }
+
+        return pending.future
+    }
+
+    /// Holds the loop and future until the task completes, so that they are released while holding the GIL
+    /// rather than wherever the task happens to finish.
+    private final class PendingFuture {
+        private var loop: PythonObject?
+        private(set) var future: PythonObject?
+
+        init(loop: PythonObject, future: PythonObject) {
+            self.loop = loop
+            self.future = future
+        }
+
+        /// Must be called holding the GIL
+        func resolve(with value: PythonObject) {
+            if let loop = loop, let future = future {
+                // fails only if the loop has since been closed, in which case no-one is waiting
+                _ = try? loop.call_soon_threadsafe.throwing.dynamicallyCall(withArguments: [PythonAwaitable.resolve, future, value])
+            }
+            loop = nil
+            future = nil
+        }
+    }
+}
+#endif
@@ -0,0 +1,136 @@
+//
+//  PythonAxisLambda.swift
+//
+//
+//  Created by strictlyswift on 17-Oct-26.
+//
+
+import PythonKit
+import libpylamsupport
+
+/// Whether to apply a function to each row, or each column, of a two-dimensional array
+public enum PythonAxis {
+    case rows
+    case columns
+}
+
+/// A read-only view of evenly-spaced elements in memory, such as one row or column of a two-dimensional NumPy array.
+///
+/// It's only valid during the call it's passed to, so must not escape it.
+public struct StridedBufferView<Element>: RandomAccessCollection {
+    private let base: UnsafeRawPointer
+    /// Distance between elements, in bytes
+    public let stride: Int
+    public let count: Int
+
+    init(base: UnsafeRawPointer, count: Int, stride: Int) {
+        self.base = base
+        self.count = count
+        self.stride = stride
+    }
+
+    public var startIndex: Int { 0 }
+    public var endIndex: Int { count }
+
+    @inline(__always)
+    public subscript(position: Int) -> Element {
+        base.load(fromByteOffset: position * stride, as: Element.self)
+    }
+
+    public func withContiguousStorageIfAvailable<R>(_ body: (UnsafeBufferPointer<Element>) throws -> R) rethrows -> R? {
+        guard stride == MemoryLayout<Element>.stride else { return nil }
+        return try body(UnsafeBufferPointer(start: base.assumingMemoryBound(to: Element.self), count: count))
+    }
+}
+
+extension PythonLambda {
+
+    /// Applies a Swift function to every row or column of a two-dimensional array, like
+    /// `df.apply(𝝺{(row:PythonObject) in ...}, axis: 1)` but without creating a Series (or calling Python) per row:
+    /// each row or column is passed as a view straight onto the array's memory.
+    ///
+    /// The rows or columns are split across cores. Where the elements of a row or column aren't adjacent in memory
+    /// (eg the columns of a row-major array), blocks of neighbouring rows or columns are first copied out together,
+    /// reading the array in memory order, so that the function always reads contiguous memory.
+    ///
+    /// - Example:
+    ///
+    ///       let totals = PythonLambda.applyAlongAxis(df, axis: .rows) { (row:StridedBufferView<Double>) in row.reduce(0, +) }
+    ///
+    /// - Parameters:
+    ///   - array: a two-dimensional array-like, eg a NumPy array or a DataFrame, converted to `T` if need be
+    ///   - axis: whether to call `fn` once per row or once per column
+    ///   - fn: computes a result from a row or column; it runs with the GIL released, and may be called from several
+    ///     threads at once
+    /// - Returns: the results, as a Series indexed by the DataFrame's index (for rows) or columns, if `array` is a
+    ///   DataFrame, or otherwise as a NumPy array
+    public static func applyAlongAxis<T: PythonBufferElement, R: PythonBufferElement>(_ array: PythonObject,
+                                                                                      axis: PythonAxis,
+                                                                                      _ fn: (StridedBufferView<T>) -> R) -> PythonObject {
+        let opened = PythonBuffer.requireMatrix(array, of: T.self)
+        let source = opened.buffer
+        defer { source.release() }
+
+        // a "line" is a row or column: fn is applied to each line, of `length` elements
+        let (lines, length) = axis == .rows ? (source.shape[0], source.shape[1]) : (source.shape[1], source.shape[0])
+        let lineStride = axis == .rows ? source.strides[0] : source.strides[1]
+        let elementStride = axis == .rows ? source.strides[1] : source.strides[0]
+
+        let result = PythonNumpy.empty(lines, of: R.self)
+        let target = PythonBuffer.output(result, of: R.self, count: lines)!
+        defer { target.release() }
+
+        withExtendedLifetime(opened.owner) {
+            PythonGIL.withoutGIL {
+                let minimumLines = max(1, PythonAxisLambda.minimumElements / max(length, 1))
+                PythonParallel.forEachRange(lines, minimumChunk: minimumLines) { range in
+                    if elementStride == MemoryLayout<T>.stride {
+                        for line in range {
+                            let view = StridedBufferView<T>(base: source.baseAddress + line * lineStride, count: length, stride: elementStride)
+                            target.store(fn(view), at: line)
+                        }
+                    } else {
+                        PythonAxisLambda.applyBlocked(source.baseAddress, lines: range, length: length,
+                                                      lineStride: lineStride, elementStride: elementStride,
+                                                      into: target, fn)
+                    }
+                }
+            }
+        }
+
+        guard Bool(Python.isinstance(array, PythonPandas.pandas.DataFrame))! else { return result }
+        return PythonPandas.pandas.Series(result, index: axis == .rows ? array.index : array.columns)
+    }
+}
+
+internal enum PythonAxisLambda {
+    /// Below this many elements per core, the lines aren't split across cores
+    static let minimumElements = 1 << 14
+    /// The number of lines copied out together, enough for a 64-byte cache line of doubles
+    static let blockLines = 8
+
+    /// Applies `fn` to strided lines by copying each block of `blockLines` lines into contiguous scratch lines,
+    /// walking the block element by element so that neighbouring lines' elements are read together
+    static func applyBlocked<T: PythonBufferElement, R: PythonBufferElement>(_ base: UnsafeMutableRawPointer,
+                                                                           lines: Range<Int>, length: Int,
+                                                                           lineStride: Int, elementStride: Int,
+                                                                           into target: PythonBuffer,
+                                                                           _ fn: (StridedBufferView<T>) -> R) {
+        let scratch = UnsafeMutablePointer<T>.allocate(capacity: blockLines * length)
+        defer { scratch.deallocate() }
+
+        for blockStart in Swift.stride(from: lines.lowerBound, to: lines.upperBound, by: blockLines) {
+            let block = min(blockLines, lines.upperBound - blockStart)
+            for i in 0..<length {
+                let element = base + blockStart * lineStride + i * elementStride
+                for j in 0..<block {
+                    scratch[j * length + i] = element.load(fromByteOffset: j * lineStride, as: T.self)
+                }
+            }
+            for j in 0..<block {
+                let view = StridedBufferView<T>(base: UnsafeRawPointer(scratch + j * length), count: length, stride: MemoryLayout<T>.stride)
+                target.store(fn(view), at: blockStart + j)
+            }
+        }
+    }
+}
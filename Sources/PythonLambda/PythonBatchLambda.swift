@@ -0,0 +1,65 @@
+//
+//  PythonBatchLambda.swift
+//
+//
+//  Created by strictlyswift on 17-Oct-26.
+//
+
+import PythonKit
+import libpylamsupport
+
+extension PythonLambda {
+
+    /// Creates a *batch* lambda, which applies a Swift function to every element of an array in one call, reading
+    /// and writing the arrays' memory directly rather than boxing each element.
+    ///
+    /// From Python, `f(xs)` returns a new NumPy array of the results, and `f(xs, out)` writes the results into
+    /// the existing array `out` (which must have the same length), returning it. `xs` may be any
+    /// one-dimensional NumPy array of the argument type; anything else, eg a pandas Series or a list, is first
+    /// converted with `numpy.ascontiguousarray`.
+    ///
+    /// - Example:
+    ///
+    ///       let doubler = 𝝺(batch: {(x:Double) in x*2})
+    ///       let doubled = doubler.pythonObject(np.arange(1_000_000.0))
+    ///
+    /// Narrow element types (`Float`, `Int32`, `Int16`, `UInt8`) read and write `float32`, `int32`, `int16` and
+    /// `uint8` arrays at their native width, without widening.
+    ///
+    /// - Note: the GIL is released while the function runs over the array, so it must not use any `PythonObject`s.
+    public convenience init<A: PythonBufferElement, R: PythonBufferElement>( batch fn: @escaping (A) -> R) {
+        let name = "lmb\(PythonLambda.lambdaUniqueName())"
+
+        let pfn = { (input: PyObjectPointer, output: PyObjectPointer?) in
+            PythonBatch.map(fn, input: PythonObject(unsafe: input), output: output.map { PythonObject(unsafe: $0) })
+        }
+
+        self.init(backend: PythonLambdaSupport(batch: pfn, name: name))
+    }
+}
+
+/// Drives Swift functions over whole arrays
+internal enum PythonBatch {
+
+    /// Applies `fn` to each element of `input`, writing into `output` (or a new array); returns the output array
+    /// as a new reference, or nil with a Python exception set.
+    static func map<A: PythonBufferElement, R: PythonBufferElement>(_ fn: (A) -> R, input: PythonObject, output: PythonObject?) -> PyObjectPointer? {
+        guard let column = PythonBuffer.column(input, of: A.self) else { return nil }
+        let source = column.buffer
+        defer { source.release() }
+
+        let result = output ?? PythonNumpy.empty(source.count, of: R.self)
+        guard let target = PythonBuffer.output(result, of: R.self, count: source.count) else { return nil }
+        defer { target.release() }
+
+        withExtendedLifetime(column.owner) {
+            PythonGIL.withoutGIL {
+                for i in 0..<source.count {
+                    target.store(fn(source.load(i, as: A.self)), at: i)
+                }
+            }
+        }
+
+        return UnsafeMutableRawPointer(wrapObject(result.unsafePyObject))
+    }
+}
@@ -0,0 +1,289 @@
+//
+//  PythonBuffer.swift
+//
+//
+//  Created by strictlyswift on 17-Oct-26.
+//
+
+import PythonKit
+import libpylamsupport
+
+/// The kinds of element which a buffer-protocol format code can describe
+public enum PythonBufferKind {
+    case signedInteger
+    case unsignedInteger
+    case floatingPoint
+    case boolean
+}
+
+/// Swift types which can be read from, and written to, the memory of a NumPy array (or any other object
+/// supporting the Python buffer protocol) directly, without boxing each element.
+public protocol PythonBufferElement {
+    /// The NumPy dtype for arrays of this element, eg "float64"
+    static var numpyDType: String { get }
+    /// The kind of element, used to check a buffer's format code
+    static var bufferKind: PythonBufferKind { get }
+    /// The dtype through which arrays of this element are read and written, when NumPy can't export `numpyDType`
+    /// arrays with the buffer protocol (eg "int64" for "datetime64[ns]"). Defaults to `numpyDType`.
+    static var bufferDType: String { get }
+}
+
+extension PythonBufferElement {
+    public static var bufferDType: String { numpyDType }
+}
+
+extension Double: PythonBufferElement {
+    public static var numpyDType: String { "float64" }
+    public static var bufferKind: PythonBufferKind { .floatingPoint }
+}
+
+extension Int: PythonBufferElement {
+    public static var numpyDType: String { "int64" }
+    public static var bufferKind: PythonBufferKind { .signedInteger }
+}
+
+extension Float: PythonBufferElement {
+    public static var numpyDType: String { "float32" }
+    public static var bufferKind: PythonBufferKind { .floatingPoint }
+}
+
+extension Int64: PythonBufferElement {
+    public static var numpyDType: String { "int64" }
+    public static var bufferKind: PythonBufferKind { .signedInteger }
+}
+
+extension Int32: PythonBufferElement {
+    public static var numpyDType: String { "int32" }
+    public static var bufferKind: PythonBufferKind { .signedInteger }
+}
+
+extension Int16: PythonBufferElement {
+    public static var numpyDType: String { "int16" }
+    public static var bufferKind: PythonBufferKind { .signedInteger }
+}
+
+extension UInt8: PythonBufferElement {
+    public static var numpyDType: String { "uint8" }
+    public static var bufferKind: PythonBufferKind { .unsignedInteger }
+}
+
+extension Bool: PythonBufferElement {
+    public static var numpyDType: String { "bool" }
+    public static var bufferKind: PythonBufferKind { .boolean }
+}
+
+extension PythonObject {
+    /// The underlying `PyObject`, borrowed: only valid while this `PythonObject` is alive
+    var unsafePyObject: UnsafeMutablePointer<PyObject> {
+        asUnsafePointer.assumingMemoryBound(to: PyObject.self)
+    }
+}
+
+/// The NumPy functions used to create and convert arrays
+internal enum PythonNumpy {
+    static let numpy = Python.import("numpy")
+
+    /// A new, uninitialised, one-dimensional array of `T`
+    static func empty<T: PythonBufferElement>(_ count: Int, of: T.Type) -> PythonObject {
+        numpy.empty(count, dtype: T.numpyDType)
+    }
+
+    /// A new one-dimensional array holding `values`, copied in directly rather than element by element
+    static func array<T: PythonBufferElement>(_ values: [T]) -> PythonObject {
+        let result = empty(values.count, of: T.self)
+        let target = PythonBuffer.output(result, of: T.self, count: values.count)!
+        defer { target.release() }
+        for (i, value) in values.enumerated() {
+            target.store(value, at: i)
+        }
+        return result
+    }
+
+    /// `object` as a contiguous one-dimensional array of `T` (viewed as `T.bufferDType`), copying only if needed;
+    /// nil (with a Python exception set) if it can't be converted
+    static func contiguous<T: PythonBufferElement>(_ object: PythonObject, of: T.Type) -> PythonObject? {
+        do {
+            let converted = try numpy.ascontiguousarray.throwing.dynamicallyCall(withKeywordArguments: ["": object, "dtype": T.numpyDType])
+            return T.bufferDType == T.numpyDType ? converted : try converted.view.throwing.dynamicallyCall(withArguments: T.bufferDType)
+        } catch {
+            raisePythonError("PyExc_TypeError", "expected an array-like of \(T.numpyDType)")
+            return nil
+        }
+    }
+}
+
+/// The pandas functions used to present results
+internal enum PythonPandas {
+    static let pandas = Python.import("pandas")
+
+    /// `array` as a Series indexed and named like `column`, if `column` is a Series; otherwise `array` itself
+    static func seriesLike(_ column: PythonObject, _ array: PythonObject) -> PythonObject {
+        guard Bool(Python.isinstance(column, pandas.Series))! else { return array }
+        return pandas.Series(array, index: column.index, name: column.name)
+    }
+}
+
+/// A view onto the memory of a Python object exporting the buffer protocol, eg a NumPy array.
+///
+/// The view must be released, while holding the GIL, once finished with. Between opening and releasing it,
+/// elements may be read and written without the GIL.
+internal final class PythonBuffer {
+    private var view: UnsafeMutablePointer<Py_buffer>?
+    let baseAddress: UnsafeMutableRawPointer
+    let itemSize: Int
+    let shape: [Int]
+    /// Distance between elements, in bytes, along each dimension
+    let strides: [Int]
+    private let format: String
+
+    /// Number of elements along the first dimension
+    var count: Int { shape.first ?? 1 }
+    /// Distance between elements along the first dimension, in bytes
+    var stride: Int { strides.first ?? itemSize }
+
+    /// Opens a view onto `object`'s memory; nil, with a Python exception set, if it doesn't support the buffer
+    /// protocol (or isn't writable, when `writable` is requested).
+    init?(_ object: UnsafeMutablePointer<PyObject>, writable: Bool = false) {
+        let view = UnsafeMutablePointer<Py_buffer>.allocate(capacity: 1)
+        guard getBuffer(object, view, writable ? 1 : 0) != 0 else {
+            view.deallocate()
+            return nil
+        }
+        guard let buf = view.pointee.buf else {
+            releaseBuffer(view)
+            view.deallocate()
+            raisePythonError("PyExc_BufferError", "buffer has no memory")
+            return nil
+        }
+        let ndim = Int(view.pointee.ndim)
+
+        self.view = view
+        self.baseAddress = buf
+        self.itemSize = view.pointee.itemsize
+        self.shape = (0..<ndim).map { view.pointee.shape![$0] }
+        self.strides = (0..<ndim).map { view.pointee.strides![$0] }
+        self.format = view.pointee.format.map { String(cString: $0) } ?? "B"
+    }
+
+    convenience init?(_ object: PythonObject, writable: Bool = false) {
+        self.init(object.unsafePyObject, writable: writable)
+    }
+
+    /// Whether the buffer's elements are `T`s, according to its format code and item size
+    func holds<T: PythonBufferElement>(_: T.Type) -> Bool {
+        guard itemSize == MemoryLayout<T>.size else { return false }
+
+        // native, or explicitly little-endian, byte order only
+        var code = Substring(format)
+        if let order = code.first, "@=<".contains(order) {
+            code = code.dropFirst()
+        }
+        guard code.count == 1, let c = code.first else { return false }
+
+        switch T.bufferKind {
+        case .signedInteger:   return "bhilqn".contains(c)
+        case .unsignedInteger: return "BHILQN".contains(c)
+        case .floatingPoint:   return "efd".contains(c)
+        case .boolean:         return c == "?"
+        }
+    }
+
+    /// Whether this is a one-dimensional buffer of `T`s
+    func isColumn<T: PythonBufferElement>(of: T.Type) -> Bool {
+        shape.count == 1 && holds(T.self)
+    }
+
+    @inline(__always)
+    func load<T>(_ index: Int, as: T.Type) -> T {
+        baseAddress.load(fromByteOffset: index * stride, as: T.self)
+    }
+
+    @inline(__always)
+    func store<T>(_ value: T, at index: Int) {
+        baseAddress.storeBytes(of: value, toByteOffset: index * stride, as: T.self)
+    }
+
+    /// Releases the view. Must be called holding the GIL.
+    func release() {
+        guard let view = view else { return }
+        releaseBuffer(view)
+        view.deallocate()
+        self.view = nil
+    }
+
+    /// Opens `object` as a one-dimensional buffer of `T`, converting it with `numpy.ascontiguousarray` if it isn't
+    /// one already (eg a pandas Series or a list). Returns the buffer along with the object it views, which must be
+    /// kept alive until the buffer is released; or nil, with a Python exception set.
+    static func column<T: PythonBufferElement>(_ object: PythonObject, of: T.Type) -> (buffer: PythonBuffer, owner: PythonObject)? {
+        if let buffer = PythonBuffer(object) {
+            if buffer.isColumn(of: T.self) {
+                return (buffer, object)
+            }
+            buffer.release()
+        } else {
+            clearPythonError()
+        }
+
+        guard let converted = PythonNumpy.contiguous(object, of: T.self),
+            let buffer = PythonBuffer(converted) else { return nil }
+        return (buffer, converted)
+    }
+
+    /// Opens `object` as a column for a Swift-side API, like `column(_:of:)`. As with PythonKit's non-throwing
+    /// calls, it's a fatal error if `object` can't be converted.
+    static func requireColumn<T: PythonBufferElement>(_ object: PythonObject, of: T.Type) -> (buffer: PythonBuffer, owner: PythonObject) {
+        guard let opened = column(object, of: T.self) else {
+            clearPythonError()
+            fatalError("expected an array-like of \(T.numpyDType)")
+        }
+        return opened
+    }
+
+    /// Opens `object` as a two-dimensional buffer of `T`, like `requireColumn(_:of:)` but converting with
+    /// `numpy.asarray`, which keeps an array's own layout (row- or column-major) when it's already of `T`.
+    static func requireMatrix<T: PythonBufferElement>(_ object: PythonObject, of: T.Type) -> (buffer: PythonBuffer, owner: PythonObject) {
+        if let buffer = PythonBuffer(object) {
+            if buffer.shape.count == 2 && buffer.holds(T.self) {
+                return (buffer, object)
+            }
+            buffer.release()
+        } else {
+            clearPythonError()
+        }
+
+        guard var converted = try? PythonNumpy.numpy.asarray.throwing.dynamicallyCall(withKeywordArguments: ["": object, "dtype": T.numpyDType]) else {
+            fatalError("expected a two-dimensional array-like of \(T.numpyDType)")
+        }
+        if T.bufferDType != T.numpyDType {
+            converted = converted.view(T.bufferDType)
+        }
+        guard let buffer = PythonBuffer(converted), buffer.shape.count == 2 else {
+            clearPythonError()
+            fatalError("expected a two-dimensional array-like of \(T.numpyDType)")
+        }
+        return (buffer, converted)
+    }
+
+    /// Opens `object` as a writable one-dimensional buffer of `count` `T`s; or nil, with a Python exception set.
+    static func output<T: PythonBufferElement>(_ object: PythonObject, of: T.Type, count: Int) -> PythonBuffer? {
+        guard let viewed = bufferView(of: object, as: T.self) else {
+            raisePythonError("PyExc_ValueError", "output must be a writable one-dimensional array of \(count) \(T.numpyDType)")
+            return nil
+        }
+        guard let buffer = PythonBuffer(viewed, writable: true) else { return nil }
+        guard buffer.isColumn(of: T.self), buffer.count == count else {
+            buffer.release()
+            raisePythonError("PyExc_ValueError", "output must be a writable one-dimensional array of \(count) \(T.numpyDType)")
+            return nil
+        }
+        return buffer
+    }
+
+    /// `object` viewed as `T.bufferDType`, if that differs from `T.numpyDType`; nil if it isn't an array of
+    /// `T.numpyDType`. The view shares the array's memory, and a buffer opened on it keeps it alive.
+    private static func bufferView<T: PythonBufferElement>(of object: PythonObject, as: T.Type) -> PythonObject? {
+        guard T.bufferDType != T.numpyDType else { return object }
+        guard let dtype = object.checking.dtype, dtype == PythonNumpy.numpy.dtype(T.numpyDType) else { return nil }
+        return try? object.view.throwing.dynamicallyCall(withArguments: T.bufferDType)
+    }
+}
@@ -0,0 +1,89 @@
+//
+//  PythonBytesLambda.swift
+//
+//
+//  Created by strictlyswift on 17-Oct-26.
+//
+
+import PythonKit
+import libpylamsupport
+
+extension PythonLambda {
+
+    /// Creates a lambda over binary data, which reads a `bytes`, `bytearray` or (contiguous) `memoryview` argument
+    /// in place, without copying it.
+    ///
+    /// - Example:
+    ///
+    ///       let checksum = 𝝺{(data:UnsafeRawBufferPointer) in data.reduce(0) { ($0 &* 31) &+ Int($1) }}
+    ///       let reversed = 𝝺{(data:UnsafeRawBufferPointer) in
+    ///           PythonBytes(count: data.count) { out in
+    ///               for i in 0..<data.count { out[i] = data[data.count - 1 - i] }
+    ///           }
+    ///       }
+    ///
+    /// - Note: the buffer is only valid during the call, so must not escape the function.
+    public convenience init<R: PythonLambdaResult>(_ fn: @escaping (UnsafeRawBufferPointer) -> R) {
+        let pfn: PythonFastcallFunction = { args, nargs, kwnames in
+            guard let args = PythonTypedArguments.positional(args, nargs, kwnames, count: 1) else { return nil }
+            return PythonBytes.withContents(of: args[0]!) { fn($0).boxed() }?.assumingMemoryBound(to: PyObject.self)
+        }
+        self.init(backend: PythonLambdaSupport(fastcall: pfn, name: "lmb\(PythonLambda.lambdaUniqueName())"))
+    }
+}
+
+/// A Python `bytes` object, filled in directly from Swift, which a lambda can return without any further copying.
+///
+/// Must be created holding the GIL, eg within a lambda.
+public final class PythonBytes: PythonLambdaResult, PythonConvertible {
+    // nil if the bytes couldn't be allocated, in which case a Python MemoryError is set
+    private let object: UnsafeMutablePointer<PyObject>?
+    public let count: Int
+
+    /// Reserves `count` bytes, then calls `fill` to write every one of them
+    public init(count: Int, fill: (UnsafeMutableRawBufferPointer) -> Void) {
+        var contents: UnsafeMutablePointer<CChar>? = nil
+        self.object = newBytes(count, &contents)
+        self.count = count
+        if object != nil {
+            fill(UnsafeMutableRawBufferPointer(start: contents, count: count))
+        }
+    }
+
+    deinit {
+        if let object = object {
+            decRef(object)
+        }
+    }
+
+    public func boxed() -> UnsafeMutableRawPointer? {
+        guard let object = object else { return nil }
+        incRef(object)
+        return UnsafeMutableRawPointer(object)
+    }
+
+    /// The `bytes` object, eg to pass to Python outside a lambda
+    public var pythonObject: PythonObject {
+        guard let object = object else { fatalError("\(count) bytes could not be allocated") }
+        return PythonObject(unsafe: UnsafeMutableRawPointer(object))
+    }
+
+    /// Calls `body` with the contents of a bytes-like object; nil, with a Python exception set, if it isn't one
+    static func withContents<R>(of object: UnsafeMutablePointer<PyObject>, _ body: (UnsafeRawBufferPointer) -> R?) -> R? {
+        let view = UnsafeMutablePointer<Py_buffer>.allocate(capacity: 1)
+        defer { view.deallocate() }
+        guard getContiguousBuffer(object, view) != 0 else { return nil }
+        defer { releaseBuffer(view) }
+
+        return body(UnsafeRawBufferPointer(start: view.pointee.buf, count: view.pointee.len))
+    }
+}
+
+/// Byte arrays are returned as `bytes`
+extension Array: PythonLambdaResult where Element == UInt8 {
+    public func boxed() -> UnsafeMutableRawPointer? {
+        withUnsafeBytes { bytes in
+            UnsafeMutableRawPointer(boxBytes(bytes.baseAddress?.assumingMemoryBound(to: CChar.self), bytes.count))
+        }
+    }
+}
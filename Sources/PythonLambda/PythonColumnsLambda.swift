@@ -0,0 +1,65 @@
+//
+//  PythonColumnsLambda.swift
+//
+//
+//  Created by strictlyswift on 17-Oct-26.
+//
+
+import PythonKit
+import libpylamsupport
+
+extension PythonLambda {
+
+    /// Applies the same Swift function to every element of many columns of a DataFrame, like
+    /// `df[columns].apply(𝝺{(column:PythonObject) in ...})` but without a Series or Python call per column.
+    ///
+    /// Each column's memory is read directly, and the columns (split into chunks of rows, when there are few
+    /// columns) are transformed across all cores with the GIL released. The results are written into a single
+    /// column-major array, so the returned DataFrame has one consolidated block.
+    ///
+    /// - Example:
+    ///
+    ///       let clipped = PythonLambda.applyColumns(df, columns: ["a", "b", "c"]) { (x:Double) in min(max(x, -3), 3) }
+    ///
+    /// - Parameters:
+    ///   - frame: the DataFrame whose columns are transformed
+    ///   - columns: the names of the columns to transform; all of them, if nil
+    ///   - fn: the transform, which may be called from several threads at once
+    /// - Returns: a new DataFrame of the transformed columns, with the same index as `frame`
+    public static func applyColumns<T: PythonBufferElement, R: PythonBufferElement>(_ frame: PythonObject,
+                                                                                    columns: [String]? = nil,
+                                                                                    _ fn: (T) -> R) -> PythonObject {
+        let names: PythonObject = columns.map { PythonObject($0) } ?? frame.columns
+        let opened = Python.list(names).map { PythonBuffer.requireColumn(frame[$0], of: T.self) }
+        let sources = opened.map { $0.buffer }
+        defer { sources.forEach { $0.release() } }
+        let rows = Int(Python.len(frame))!
+
+        let result = PythonNumpy.numpy.empty(PythonObject(tupleOf: rows, sources.count), dtype: R.numpyDType, order: "F")
+        let viewed = R.bufferDType == R.numpyDType ? result : result.view(R.bufferDType)
+        let target = PythonBuffer(viewed, writable: true)!
+        defer { target.release() }
+
+        withExtendedLifetime(opened.map { $0.owner }) {
+            PythonGIL.withoutGIL {
+                let chunks = PythonParallel.ranges(rows, pieces: max(1, PythonParallel.concurrency / max(sources.count, 1)),
+                                                   minimumChunk: PythonColumns.minimumChunk)
+                PythonParallel.forEach(sources.count * chunks.count) { item in
+                    let (column, chunk) = item.quotientAndRemainder(dividingBy: chunks.count)
+                    let source = sources[column]
+                    let output = target.baseAddress + column * target.strides[1]
+                    for i in chunks[chunk] {
+                        output.storeBytes(of: fn(source.load(i, as: T.self)), toByteOffset: i * target.strides[0], as: R.self)
+                    }
+                }
+            }
+        }
+
+        return PythonPandas.pandas.DataFrame(result, index: frame.index, columns: names, copy: false)
+    }
+}
+
+internal enum PythonColumns {
+    /// Below this many rows, a column isn't split between cores
+    static let minimumChunk = 1 << 15
+}
@@ -0,0 +1,48 @@
+//
+//  PythonDispatchLambda.swift
+//
+//
+//  Created by strictlyswift on 17-Oct-26.
+//
+
+import PythonKit
+import libpylamsupport
+
+extension PythonLambda {
+
+    /// Creates a lambda over a mix of ints, floats and `None`, as found in pandas `object` columns, with one Swift
+    /// function for each kind of argument.
+    ///
+    /// The function is chosen by the argument's exact type (NumPy integer and floating scalars included), and the
+    /// argument unboxed directly, so no `PythonObject` is created. Anything else goes to `onOther` if given, or
+    /// raises `TypeError`.
+    ///
+    /// - Example:
+    ///
+    ///       let cleaned = 𝝺(onInt: { Double($0) }, onDouble: { $0.isNaN ? 0 : $0 }, onNone: { 0.0 })
+    ///       df["amount"] = df.amount.apply(cleaned)
+    public convenience init<R: PythonLambdaResult>( onInt: @escaping (Int) -> R,
+                                                     onDouble: @escaping (Double) -> R,
+                                                     onNone: @escaping () -> R,
+                                                     onOther: ((PythonObject) -> R)? = nil) {
+        let pfn: PythonFastcallFunction = { args, nargs, kwnames in
+            guard let args = PythonTypedArguments.positional(args, nargs, kwnames, count: 1) else { return nil }
+
+            var intValue: CLong = 0
+            var doubleValue: Double = 0
+            switch classifyNumber(args[0]!, &intValue, &doubleValue) {
+            case NUMBER_KIND_INT:    return PythonTypedArguments.result(onInt(Int(intValue)))
+            case NUMBER_KIND_DOUBLE: return PythonTypedArguments.result(onDouble(doubleValue))
+            case NUMBER_KIND_NONE:   return PythonTypedArguments.result(onNone())
+            case NUMBER_KIND_ERROR:  return nil
+            default:
+                guard let onOther = onOther else {
+                    raisePythonError("PyExc_TypeError", "expected an int, float or None")
+                    return nil
+                }
+                return PythonTypedArguments.result(onOther(PythonObject(unsafe: UnsafeMutableRawPointer(args[0]!))))
+            }
+        }
+        self.init(backend: PythonLambdaSupport(fastcall: pfn, name: "lmb\(PythonLambda.lambdaUniqueName())"))
+    }
+}
@@ -0,0 +1,229 @@
+//
+//  PythonExecutor.swift
+//
+//
+//  Created by strictlyswift on 17-Oct-26.
+//
+
+#if compiler(>=5.5) && canImport(_Concurrency)
+import Foundation
+import PythonKit
+import libpylamsupport
+
+/// A snapshot of the work done by a `PythonExecutor`.
+public struct PythonExecutorMetrics {
+    /// Number of jobs waiting to run when the snapshot was taken
+    public let queueDepth: Int
+    /// Largest number of jobs seen waiting at once
+    public let maxQueueDepth: Int
+    /// Number of batches run, ie the number of times the GIL has been acquired
+    public let batchesRun: Int
+    /// Number of jobs run
+    public let jobsRun: Int
+    /// Total time spent waiting to acquire the GIL, in nanoseconds
+    public let totalGILWaitNanoseconds: UInt64
+    /// Total time the GIL has been held, in nanoseconds
+    public let totalGILHoldNanoseconds: UInt64
+    /// Longest time the GIL has been held for a single batch, in nanoseconds
+    public let maxGILHoldNanoseconds: UInt64
+
+    /// Average number of jobs run per GIL acquisition
+    public var averageBatchSize: Double {
+        batchesRun == 0 ? 0 : Double(jobsRun) / Double(batchesRun)
+    }
+}
+
+/// Funnels Python work from many Swift tasks onto a single thread which owns its own interpreter thread state.
+///
+/// Jobs submitted with `run` are queued; the executor thread takes everything queued (up to `maxBatchSize` jobs),
+/// acquires the GIL once, runs the jobs back to back, releases the GIL and only then resumes the waiting tasks.
+/// Under load this replaces one GIL handover per task with one per batch.
+///
+/// - Example:
+///
+///       let pd = Python.import("pandas")
+///       PythonGIL.release()      // let the executor thread have the GIL
+///       let means = try await withThrowingTaskGroup(of: Double.self) { group in
+///           for file in files {
+///               group.addTask { try await PythonExecutor.shared.run { Double(pd.read_csv(file).x.mean())! } }
+///           }
+///           return try await group.reduce(into: []) { $0.append($1) }
+///       }
+///
+/// The executor's thread is started by the first job, and runs until `shutdown()` is called (which `shared` never
+/// is), so executors other than `shared` should be shut down once finished with.
+///
+/// - Note: the thread which initialised Python holds the GIL until it gives it up, eg with `PythonGIL.release()`
+/// or `PythonGIL.withoutGIL`; until then queued jobs cannot run. Jobs should return Swift values rather than
+/// `PythonObject`s, since results are handed back to the caller after the GIL has been released.
+@available(macOS 10.15, iOS 13.0, watchOS 6.0, tvOS 13.0, *)
+public final class PythonExecutor {
+    /// The executor used by default
+    public static let shared = PythonExecutor()
+
+    /// The largest number of jobs run under a single acquisition of the GIL
+    public let maxBatchSize: Int
+
+    // a job runs holding the GIL, and returns the work to do (resuming the caller) once it's released
+    private typealias Job = () -> () -> Void
+
+    private var condition = NSCondition()
+    private var queue: [Job] = []
+    private var started = false
+    private var stopping = false
+
+    private var maxQueueDepth = 0
+    private var batchesRun = 0
+    private var jobsRun = 0
+    private var totalGILWait: UInt64 = 0
+    private var totalGILHold: UInt64 = 0
+    private var maxGILHold: UInt64 = 0
+
+    public init(maxBatchSize: Int = 256) {
+        precondition(maxBatchSize > 0, "maxBatchSize must be positive")
+        self.maxBatchSize = maxBatchSize
+        PythonExecutor.track(self)
+    }
+
+    /// Runs `body` on the executor thread while holding the GIL, suspending the calling task until it completes.
+    ///
+    /// - Throws: `CancellationError` if the executor has been shut down, or whatever `body` throws
+    public func run<T>(_ body: @escaping () throws -> T) async throws -> T {
+        try await withCheckedThrowingContinuation { continuation in
+            let accepted = self.enqueue {
+                let result = Result { try body() }
+                return { continuation.resume(with: result) }
+            }
+            if !accepted {
+                continuation.resume(throwing: CancellationError())
+            }
+        }
+    }
+
+    /// Stops the executor: jobs already queued are still run, but later calls to `run` throw `CancellationError`.
+    /// The executor thread then exits, releasing its interpreter thread state (and its reference to the executor).
+    /// Returns without waiting for the queued jobs.
+    public func shutdown() {
+        condition.lock()
+        stopping = true
+        condition.broadcast()
+        condition.unlock()
+    }
+
+    /// The current metrics for this executor
+    public var metrics: PythonExecutorMetrics {
+        condition.lock()
+        defer { condition.unlock() }
+        return PythonExecutorMetrics(
+            queueDepth: queue.count,
+            maxQueueDepth: maxQueueDepth,
+            batchesRun: batchesRun,
+            jobsRun: jobsRun,
+            totalGILWaitNanoseconds: totalGILWait,
+            totalGILHoldNanoseconds: totalGILHold,
+            maxGILHoldNanoseconds: maxGILHold
+        )
+    }
+
+    /// Queues the job, returning false (without queueing it) if the executor has been shut down
+    private func enqueue(_ job: @escaping Job) -> Bool {
+        condition.lock()
+        defer { condition.unlock() }
+        guard !stopping else { return false }
+        queue.append(job)
+        maxQueueDepth = max(maxQueueDepth, queue.count)
+        if !started {
+            started = true
+            let thread = Thread { self.serve() }
+            thread.name = "PythonExecutor"
+            thread.start()
+        }
+        condition.signal()
+        return true
+    }
+
+    /// The next jobs to run, waiting for some if need be; nil once the executor is shut down and its queue empty
+    private func nextBatch() -> ArraySlice<Job>? {
+        condition.lock()
+        defer { condition.unlock() }
+        while queue.isEmpty {
+            if stopping {
+                return nil
+            }
+            condition.wait()
+        }
+        let batch = queue.prefix(maxBatchSize)
+        queue.removeFirst(batch.count)
+        return batch
+    }
+
+    private func serve() {
+        _ = pythonCLibrary
+
+        // create this thread's interpreter state once, rather than on every acquisition
+        let gilState = acquireGIL()
+        let threadState = saveThread()
+
+        while var batch = nextBatch() {
+            let batchSize = batch.count
+
+            let requested = DispatchTime.now().uptimeNanoseconds
+            restoreThread(threadState)
+            let acquired = DispatchTime.now().uptimeNanoseconds
+            let resumes = batch.map { job in job() }
+            // drop the jobs, and any Python objects they captured, while still holding the GIL
+            batch = []
+            _ = saveThread()
+            let released = DispatchTime.now().uptimeNanoseconds
+
+            record(batchSize: batchSize, waited: acquired - requested, held: released - acquired)
+            resumes.forEach { resume in resume() }
+        }
+
+        // shut down: release the interpreter state created above
+        restoreThread(threadState)
+        releaseGIL(gilState)
+    }
+
+    /// Only the forking thread survives a fork, so in the child the executor thread is gone and the lock may be
+    /// held by a thread which no longer exists; so the lock is replaced rather than taken. Start afresh: the queued
+    /// jobs belong to the parent's tasks, so are dropped, without being run or resumed.
+    private func resetAfterFork() {
+        condition = NSCondition()
+        queue = []
+        started = false
+    }
+
+    // every live executor, so that a forked child can reset them all
+    private static var executorsLock = NSLock()
+    private static var executors: [WeakExecutor] = []
+
+    private struct WeakExecutor {
+        weak var executor: PythonExecutor?
+    }
+
+    private static func track(_ executor: PythonExecutor) {
+        executorsLock.lock()
+        defer { executorsLock.unlock() }
+        executors.removeAll { $0.executor == nil }
+        executors.append(WeakExecutor(executor: executor))
+    }
+
+    /// Resets every executor in a forked child. Called by the only thread in the child, so the lock (which another
+    /// thread may have held at the fork) is replaced rather than taken.
+    internal static func resetAllAfterFork() {
+        executorsLock = NSLock()
+        executors.forEach { $0.executor?.resetAfterFork() }
+    }
+
+    private func record(batchSize: Int, waited: UInt64, held: UInt64) {
+        condition.lock()
+        defer { condition.unlock() }
+        batchesRun += 1
+        jobsRun += batchSize
+        totalGILWait += waited
+        totalGILHold += held
+        maxGILHold = max(maxGILHold, held)
+    }
+}
+#endif
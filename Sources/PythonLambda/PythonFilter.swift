@@ -0,0 +1,110 @@
+//
+//  PythonFilter.swift
+//
+//
+//  Created by strictlyswift on 17-Oct-26.
+//
+
+import PythonKit
+import libpylamsupport
+
+extension PythonLambda {
+
+    /// Filters a column with a Swift predicate, writing the values which pass it (or their positions) straight into
+    /// a compact array, in place of `column[column.apply(𝝺{...})]`, which builds a full-length boolean mask first.
+    ///
+    /// The column is split into chunks across cores. Each core tests its chunk, keeping the results as bits and
+    /// counting the survivors; then, with every chunk's place in the output known, each copies its survivors out.
+    /// So apart from the output, the only memory used is one bit per element.
+    ///
+    /// - Example:
+    ///
+    ///       let large = PythonLambda.filterCompact(df.price) { (p:Double) in p > 100 }
+    ///       let rows = df.iloc[PythonLambda.filterCompact(df.price, indices: true) { (p:Double) in p > 100 }]
+    ///
+    /// - Parameters:
+    ///   - column: the values to filter, as any array-like
+    ///   - indices: whether to return the positions of the values which pass, rather than the values themselves
+    ///   - predicate: the test, which runs with the GIL released, and may be called from several threads at once
+    /// - Returns: a NumPy array of the values which pass, or of their (int64) positions, in their original order
+    public static func filterCompact<T: PythonBufferElement>(_ column: PythonObject,
+                                                             indices: Bool = false,
+                                                             _ predicate: (T) -> Bool) -> PythonObject {
+        let opened = PythonBuffer.requireColumn(column, of: T.self)
+        let source = opened.buffer
+        defer { source.release() }
+
+        let chunks = PythonParallel.ranges(source.count, pieces: PythonParallel.concurrency, minimumChunk: PythonFilter.minimumChunk)
+        var passes = [[UInt64]](repeating: [], count: chunks.count)
+        var counts = [Int](repeating: 0, count: chunks.count)
+
+        // 1. test every element, keeping the results as one bit each
+        withExtendedLifetime(opened.owner) {
+            PythonGIL.withoutGIL {
+                passes.withUnsafeMutableBufferPointer { passes in
+                    counts.withUnsafeMutableBufferPointer { counts in
+                        PythonParallel.forEach(chunks.count) { c in
+                            (passes[c], counts[c]) = PythonFilter.test(source, chunks[c], predicate)
+                        }
+                    }
+                }
+            }
+        }
+
+        // 2. allocate exactly the output needed, and copy each chunk's survivors to its place in it
+        var offsets = [0]
+        for count in counts {
+            offsets.append(offsets.last! + count)
+        }
+        let total = offsets.last!
+        let result = indices ? PythonNumpy.empty(total, of: Int.self) : PythonNumpy.empty(total, of: T.self)
+        let target = indices ? PythonBuffer.output(result, of: Int.self, count: total)! : PythonBuffer.output(result, of: T.self, count: total)!
+        defer { target.release() }
+
+        withExtendedLifetime(opened.owner) {
+            PythonGIL.withoutGIL {
+                PythonParallel.forEach(chunks.count) { c in
+                    var next = offsets[c]
+                    PythonFilter.forEachPass(passes[c], in: chunks[c]) { i in
+                        if indices {
+                            target.store(i, at: next)
+                        } else {
+                            target.store(source.load(i, as: T.self), at: next)
+                        }
+                        next += 1
+                    }
+                }
+            }
+        }
+
+        return result
+    }
+}
+
+internal enum PythonFilter {
+    /// Below this many elements per chunk, filtering isn't split across cores
+    static let minimumChunk = 1 << 15
+
+    /// The elements of `chunk` which pass `predicate`, as bits relative to the start of the chunk, and how many there are
+    static func test<T>(_ source: PythonBuffer, _ chunk: Range<Int>, _ predicate: (T) -> Bool) -> ([UInt64], Int) {
+        var bits = [UInt64](repeating: 0, count: (chunk.count + 63) / 64)
+        var count = 0
+        for i in chunk where predicate(source.load(i, as: T.self)) {
+            let offset = i - chunk.lowerBound
+            bits[offset / 64] |= 1 << UInt64(offset % 64)
+            count += 1
+        }
+        return (bits, count)
+    }
+
+    /// Calls `body` with the position of each element of `chunk` whose bit is set, in order
+    static func forEachPass(_ bits: [UInt64], in chunk: Range<Int>, _ body: (Int) -> Void) {
+        for (w, word) in bits.enumerated() {
+            var remaining = word
+            while remaining != 0 {
+                body(chunk.lowerBound + w * 64 + remaining.trailingZeroBitCount)
+                remaining &= remaining - 1
+            }
+        }
+    }
+}
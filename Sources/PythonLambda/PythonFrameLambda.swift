@@ -0,0 +1,147 @@
+//
+//  PythonFrameLambda.swift
+//
+//
+//  Created by strictlyswift on 17-Oct-26.
+//
+
+import PythonKit
+import libpylamsupport
+
+extension PythonLambda {
+
+    /// Creates a *frame* lambda, which applies a Swift function returning a pair to every element of a column, and
+    /// returns the results as a two-column DataFrame, in place of `apply(..., result_type: "expand")`.
+    ///
+    /// No tuple is created per element: each component is written straight into its own column, which for
+    /// `PythonBufferElement` results is a NumPy array of that type. Other results, eg `String`s, are collected in
+    /// Swift and boxed once the whole column is done.
+    ///
+    /// From Python, `f(xs)` returns the DataFrame, indexed like `xs` if it's a Series.
+    ///
+    /// - Example:
+    ///
+    ///       let parsed = 𝝺(frame: ("length", "upper"), {(s:String) in (s.count, s.uppercased())})
+    ///       let features = parsed.pythonObject(df.name)
+    ///
+    /// - Note: the GIL is released while the function runs over the column, so it must not use any `PythonObject`s.
+    public convenience init<A: PythonLambdaArgument, R1: PythonLambdaResult, R2: PythonLambdaResult>(frame columns: (String, String),
+                                                                                                     _ fn: @escaping (A) -> (R1, R2)) {
+        let pfn = { (input: PyObjectPointer, output: PyObjectPointer?) -> PyObjectPointer? in
+            PythonFrame.map(PythonObject(unsafe: input), hasOutput: output != nil) { (count: Int, arguments: [A]) in
+                let first = PythonFrameColumn<R1>(count: count)
+                let second = PythonFrameColumn<R2>(count: count)
+                PythonGIL.withoutGIL {
+                    for (i, a) in arguments.enumerated() {
+                        let (r1, r2) = fn(a)
+                        first.store(r1, at: i)
+                        second.store(r2, at: i)
+                    }
+                }
+                return [columns.0: first.finish(), columns.1: second.finish()]
+            }
+        }
+        self.init(backend: PythonLambdaSupport(batch: pfn, name: "lmb\(PythonLambda.lambdaUniqueName())"))
+    }
+
+    /// Creates a frame lambda returning a triple for each element, as a three-column DataFrame
+    public convenience init<A: PythonLambdaArgument, R1: PythonLambdaResult, R2: PythonLambdaResult, R3: PythonLambdaResult>(frame columns: (String, String, String),
+                                                                                                                             _ fn: @escaping (A) -> (R1, R2, R3)) {
+        let pfn = { (input: PyObjectPointer, output: PyObjectPointer?) -> PyObjectPointer? in
+            PythonFrame.map(PythonObject(unsafe: input), hasOutput: output != nil) { (count: Int, arguments: [A]) in
+                let first = PythonFrameColumn<R1>(count: count)
+                let second = PythonFrameColumn<R2>(count: count)
+                let third = PythonFrameColumn<R3>(count: count)
+                PythonGIL.withoutGIL {
+                    for (i, a) in arguments.enumerated() {
+                        let (r1, r2, r3) = fn(a)
+                        first.store(r1, at: i)
+                        second.store(r2, at: i)
+                        third.store(r3, at: i)
+                    }
+                }
+                return [columns.0: first.finish(), columns.1: second.finish(), columns.2: third.finish()]
+            }
+        }
+        self.init(backend: PythonLambdaSupport(batch: pfn, name: "lmb\(PythonLambda.lambdaUniqueName())"))
+    }
+}
+
+internal enum PythonFrame {
+
+    /// Unboxes `input`, has `fill` compute the columns from its elements, and assembles them into a DataFrame;
+    /// returns it as a new reference, or nil with a Python exception set
+    static func map<A: PythonLambdaArgument>(_ input: PythonObject, hasOutput: Bool,
+                                             _ fill: (Int, [A]) -> KeyValuePairs<String, PythonObject?>) -> PyObjectPointer? {
+        guard !hasOutput else {
+            raisePythonError("PyExc_TypeError", "frame lambdas return a new DataFrame, so take no output")
+            return nil
+        }
+        let arguments = A.unboxedColumn(input)
+        let columns = fill(arguments.count, arguments)
+        guard columns.allSatisfy({ $0.value != nil }) else { return nil }
+
+        let pandas = PythonPandas.pandas
+        let index = Bool(Python.isinstance(input, pandas.Series))! ? input.index : Python.None
+        let data = Python.dict(columns.map { PythonObject(tupleOf: $0.key, $0.value!) })
+        let frame = pandas.DataFrame(data, index: index, copy: false)
+        return withExtendedLifetime(frame) {
+            UnsafeMutableRawPointer(wrapObject(frame.unsafePyObject))
+        }
+    }
+}
+
+/// One column of results, written element by element, possibly without the GIL. `PythonBufferElement` results are
+/// stored straight into a new NumPy array of their type; others are kept in Swift until `finish` boxes them.
+internal final class PythonFrameColumn<R: PythonLambdaResult> {
+    private let array: PythonObject?
+    private let buffer: PythonBuffer?
+    private let values: UnsafeMutablePointer<R>?
+    private var stored = 0
+
+    /// Must be called holding the GIL
+    init(count: Int) {
+        if let element = R.self as? PythonBufferElement.Type {
+            let array = PythonNumpy.numpy.empty(count, dtype: element.numpyDType)
+            let viewed = element.bufferDType == element.numpyDType ? array : array.view(element.bufferDType)
+            self.array = array
+            self.buffer = PythonBuffer(viewed, writable: true)!
+            self.values = nil
+        } else {
+            self.array = nil
+            self.buffer = nil
+            self.values = .allocate(capacity: count)
+        }
+    }
+
+    deinit {
+        if let values = values {
+            values.deinitialize(count: stored)
+            values.deallocate()
+        }
+    }
+
+    /// Stores the result for element `index`; the elements must be stored in order
+    @inline(__always)
+    func store(_ value: R, at index: Int) {
+        if let buffer = buffer {
+            buffer.store(value, at: index)
+        } else {
+            (values! + index).initialize(to: value)
+            stored += 1
+        }
+    }
+
+    /// The completed column, as an array; or nil, with a Python exception set, if a result couldn't be boxed. Must
+    /// be called holding the GIL, once every element is stored.
+    func finish() -> PythonObject? {
+        if let buffer = buffer {
+            buffer.release()
+            return array!
+        }
+        var boxed = (0..<stored).map { values![$0].boxed()?.assumingMemoryBound(to: PyObject.self) }
+        guard let tuple = packTuple(&boxed, boxed.count) else { return nil }
+        defer { decRef(tuple) }
+        return PythonNumpy.numpy.array(PythonObject(unsafe: UnsafeMutableRawPointer(tuple)), dtype: "object")
+    }
+}
@@ -0,0 +1,79 @@
+//
+//  PythonGIL.swift
+//
+//
+//  Created by strictlyswift on 17-Oct-26.
+//
+
+import libpylamsupport
+
+/// Helpers for the Python Global Interpreter Lock (GIL).
+///
+/// Python may only be called from a thread which holds the GIL. The thread which initialised Python holds it
+/// until it explicitly gives it up (or until the interpreter releases it, eg while an asyncio event loop is
+/// waiting for events), so code running on other threads must acquire it before touching any `PythonObject`.
+public enum PythonGIL {
+    private static var releasedThreadState: UnsafeMutableRawPointer? = nil
+
+    /// Runs `body` holding the GIL, acquiring it first if the current thread does not already hold it.
+    ///
+    /// - Example:
+    ///
+    ///       DispatchQueue.global().async {
+    ///           PythonGIL.withGIL { print(Python.len(myList)) }
+    ///       }
+    public static func withGIL<T>(_ body: () throws -> T) rethrows -> T {
+        _ = pythonCLibrary
+        let state = acquireGIL()
+        defer { releaseGIL(state) }
+        return try body()
+    }
+    
+    /// Runs `body` with the GIL released, so that other threads can call Python in the meantime. Must be called
+    /// from a thread which holds the GIL; `body` must not use any `PythonObject`s.
+    public static func withoutGIL<T>(_ body: () throws -> T) rethrows -> T {
+        _ = pythonCLibrary
+        let threadState = saveThread()
+        defer { restoreThread(threadState) }
+        return try body()
+    }
+    
+    /// Releases the GIL held by the thread which initialised Python, until `reacquire()` is called from that same
+    /// thread. This is needed when Python is driven entirely from other threads, eg via `PythonExecutor`.
+    public static func release() {
+        _ = pythonCLibrary
+        guard releasedThreadState == nil else { return }
+        releasedThreadState = saveThread()
+    }
+    
+    /// Reacquires the GIL given up by `release()`.
+    public static func reacquire() {
+        guard let threadState = releasedThreadState else { return }
+        releasedThreadState = nil
+        restoreThread(threadState)
+    }
+    
+    /// Interpreter housekeeping for a `fork()` made directly from Swift rather than through Python's `os.fork`
+    /// (which does this itself). Call `prepareForFork()` immediately before forking, then `afterForkInParent()`
+    /// or `afterForkInChild()` in the respective process. Must be called holding the GIL.
+    public static func prepareForFork() {
+        _ = pythonCLibrary
+        beforeFork()
+    }
+    
+    /// See `prepareForFork()`
+    public static func afterForkInParent() {
+        libpylamsupport.afterForkInParent()
+    }
+    
+    /// See `prepareForFork()`. Reinitialises the GIL and interpreter thread state for the forking thread, which is
+    /// the only thread to survive, and runs Python's `os.register_at_fork` child handlers.
+    public static func afterForkInChild() {
+        libpylamsupport.afterForkInChild()
+    }
+    
+    /// Forgets any thread state released by `release()`: its thread does not exist in a forked child.
+    internal static func resetAfterFork() {
+        releasedThreadState = nil
+    }
+}
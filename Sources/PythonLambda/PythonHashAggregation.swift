@@ -0,0 +1,151 @@
+//
+//  PythonHashAggregation.swift
+//
+//
+//  Created by strictlyswift on 17-Oct-26.
+//
+
+import PythonKit
+import libpylamsupport
+
+/// The statistics which `PythonLambda.aggregate` can compute for each group
+public enum PythonAggregation: String, CaseIterable {
+    case sum
+    case count
+    case min
+    case max
+    case mean
+}
+
+extension PythonLambda {
+
+    /// Groups the rows of two columns by a Swift key function, and aggregates a Swift value function over each
+    /// group, in a single pass: in place of `df.assign(k=df.a.apply(𝝺)).groupby("k").b.agg(...)`, which creates
+    /// intermediate columns and Series.
+    ///
+    /// The columns are read a block of rows at a time, and each row's key and value are computed in Swift and
+    /// accumulated into an open-addressing hash table keyed by the key, so little memory is needed beyond the
+    /// table. The result is a DataFrame indexed by key, in order of first appearance, with one column per
+    /// aggregation.
+    ///
+    /// - Example:
+    ///
+    ///       let byLength = PythonLambda.aggregate(keys: df.name, by: {(s:String) in s.count},
+    ///                                             values: df.price, {(p:Double) in p * 1.2},
+    ///                                             [.sum, .mean])
+    ///
+    /// - Parameters:
+    ///   - keyColumn: the column the key function is applied to
+    ///   - key: computes each row's group key
+    ///   - valueColumn: the column the value function is applied to, the same length as `keyColumn`
+    ///   - value: computes each row's value to aggregate
+    ///   - aggregations: the statistics to compute, in the order of the result's columns
+    ///
+    /// - Note: both functions run with the GIL released, so must not use any `PythonObject`s.
+    public static func aggregate<A: PythonLambdaArgument, K: Hashable & PythonLambdaResult, B: PythonLambdaArgument>(
+            keys keyColumn: PythonObject, by key: (A) -> K,
+            values valueColumn: PythonObject, _ value: (B) -> Double,
+            _ aggregations: [PythonAggregation] = [.sum, .count, .mean]) -> PythonObject {
+        let blockSize = 1 << 12
+        var table = PythonHashTable<K>()
+        var accumulators: [PythonAccumulator] = []
+        A.withRows(of: keyColumn) { count, keyRows in
+            B.withRows(of: valueColumn) { valueCount, valueRows in
+                precondition(count == valueCount, "key and value columns must be the same length")
+                for start in stride(from: 0, to: count, by: blockSize) {
+                    let rows = start..<min(start + blockSize, count)
+                    let keyArguments = keyRows(rows)
+                    let valueArguments = valueRows(rows)
+                    PythonGIL.withoutGIL {
+                        for row in 0..<rows.count {
+                            let group = table.group(for: key(keyArguments[row]))
+                            if group == accumulators.count {
+                                accumulators.append(PythonAccumulator())
+                            }
+                            accumulators[group].add(value(valueArguments[row]))
+                        }
+                    }
+                }
+            }
+        }
+
+        let pandas = PythonPandas.pandas
+        let index = pandas.Index(table.keys.map { $0.boxedPythonObject }, name: keyColumn.checking.name ?? Python.None)
+        var columns: [String: PythonObject] = [:]
+        for aggregation in aggregations {
+            columns[aggregation.rawValue] = aggregation == .count
+                ? PythonNumpy.array(accumulators.map { $0.count })
+                : PythonNumpy.array(accumulators.map { $0.statistic(aggregation) })
+        }
+        return pandas.DataFrame(columns, index: index, columns: aggregations.map { $0.rawValue })
+    }
+}
+
+/// Running statistics for one group
+internal struct PythonAccumulator {
+    var sum = 0.0
+    var count = 0
+    var min = Double.infinity
+    var max = -Double.infinity
+
+    @inline(__always)
+    mutating func add(_ value: Double) {
+        sum += value
+        count += 1
+        min = Swift.min(min, value)
+        max = Swift.max(max, value)
+    }
+
+    func statistic(_ aggregation: PythonAggregation) -> Double {
+        switch aggregation {
+        case .sum:   return sum
+        case .count: return Double(count)
+        case .min:   return min
+        case .max:   return max
+        case .mean:  return sum / Double(count)
+        }
+    }
+}
+
+/// An open-addressing (linear probing) hash table assigning each distinct key a dense group number, in order of
+/// first appearance
+internal struct PythonHashTable<K: Hashable> {
+    /// The distinct keys, indexed by group
+    private(set) var keys: [K] = []
+    // group number for each slot, or -1 if empty; the count is always a power of 2, at most half full
+    private var slots = [Int](repeating: -1, count: 16)
+
+    /// The group for `key`, adding a new group if it hasn't been seen before
+    @inline(__always)
+    mutating func group(for key: K) -> Int {
+        let mask = slots.count - 1
+        var slot = key.hashValue & mask
+        while true {
+            let group = slots[slot]
+            if group < 0 {
+                slots[slot] = keys.count
+                keys.append(key)
+                if keys.count * 2 > slots.count {
+                    grow()
+                }
+                return keys.count - 1
+            }
+            if keys[group] == key {
+                return group
+            }
+            slot = (slot + 1) & mask
+        }
+    }
+
+    private mutating func grow() {
+        slots = [Int](repeating: -1, count: slots.count * 2)
+        let mask = slots.count - 1
+        for (group, key) in keys.enumerated() {
+            var slot = key.hashValue & mask
+            while slots[slot] >= 0 {
+                slot = (slot + 1) & mask
+            }
+            slots[slot] = group
+        }
+    }
+}
@@ -0,0 +1,102 @@
+//
+//  PythonHistogram.swift
+//
+//
+//  Created by strictlyswift on 17-Oct-26.
+//
+
+import PythonKit
+import libpylamsupport
+
+extension PythonLambda {
+
+    /// Counts the values of a column falling into each bucket, as chosen by a Swift function, in place of
+    /// `column.apply(𝝺{...}).value_counts()`, without creating the intermediate column of buckets.
+    ///
+    /// Chunks of the column are counted across cores, each into its own counts, which are added up at the end.
+    ///
+    /// - Example:
+    ///
+    ///       let byDecade = PythonLambda.histogram(df.age, buckets: 12) { (age:Int) in age / 10 }
+    ///
+    /// - Parameters:
+    ///   - column: the values to count, as any array-like
+    ///   - buckets: the number of buckets
+    ///   - bucket: the bucket for a value, in `0..<buckets`; values given any other bucket aren't counted. It runs
+    ///     with the GIL released, and may be called from several threads at once.
+    /// - Returns: a NumPy array of the (int64) count in each bucket
+    public static func histogram<T: PythonBufferElement>(_ column: PythonObject, buckets: Int, _ bucket: (T) -> Int) -> PythonObject {
+        precondition(buckets >= 0, "the number of buckets can't be negative")
+        return PythonHistogram.count(column, buckets: buckets, bucket)
+    }
+
+    /// Counts the values of a column falling between each pair of consecutive `edges`, like `numpy.histogram(column,
+    /// bins: edges)`: each bucket includes its lower edge, and the last its upper edge too. Values outside the
+    /// edges, and NaNs, aren't counted.
+    ///
+    /// - Example:
+    ///
+    ///       let counts = PythonLambda.histogram(df.price, edges: [0, 10, 100, 1000])
+    ///
+    /// - Returns: a NumPy array of the (int64) count in each bucket, one fewer than the number of edges
+    public static func histogram(_ column: PythonObject, edges: [Double]) -> PythonObject {
+        precondition(edges.count >= 2, "there must be at least two edges")
+        precondition(zip(edges, edges.dropFirst()).allSatisfy { $0 <= $1 }, "edges must be in increasing order")
+        let last = edges.count - 2
+
+        return PythonHistogram.count(column, buckets: edges.count - 1) { (x: Double) -> Int in
+            guard x >= edges[0] && x <= edges[last + 1] else { return -1 }
+            // the number of edges <= x, less one, is x's bucket
+            var low = 1
+            var high = edges.count
+            while low < high {
+                let mid = (low + high) / 2
+                if edges[mid] <= x {
+                    low = mid + 1
+                } else {
+                    high = mid
+                }
+            }
+            return min(low - 1, last)
+        }
+    }
+}
+
+internal enum PythonHistogram {
+    /// Below this many values per chunk, counting isn't split across cores
+    static let minimumChunk = 1 << 15
+
+    /// Counts `column`'s values into buckets chosen by `bucket`, with a separate count array per chunk
+    static func count<T: PythonBufferElement>(_ column: PythonObject, buckets: Int, _ bucket: (T) -> Int) -> PythonObject {
+        let opened = PythonBuffer.requireColumn(column, of: T.self)
+        let source = opened.buffer
+        defer { source.release() }
+
+        let chunks = PythonParallel.ranges(source.count, pieces: PythonParallel.concurrency, minimumChunk: minimumChunk)
+        var partial = [[Int]](repeating: [], count: chunks.count)
+
+        let totals: [Int] = withExtendedLifetime(opened.owner) {
+            PythonGIL.withoutGIL {
+                partial.withUnsafeMutableBufferPointer { partial in
+                    PythonParallel.forEach(chunks.count) { c in
+                        var counts = [Int](repeating: 0, count: buckets)
+                        for i in chunks[c] {
+                            let b = bucket(source.load(i, as: T.self))
+                            if b >= 0 && b < buckets {
+                                counts[b] += 1
+                            }
+                        }
+                        partial[c] = counts
+                    }
+                }
+                return partial.reduce(into: [Int](repeating: 0, count: buckets)) { totals, counts in
+                    for b in 0..<counts.count {
+                        totals[b] += counts[b]
+                    }
+                }
+            }
+        }
+
+        return PythonNumpy.array(totals)
+    }
+}
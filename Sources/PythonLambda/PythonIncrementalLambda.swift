@@ -0,0 +1,125 @@
+//
+//  PythonIncrementalLambda.swift
+//
+//
+//  Created by strictlyswift on 17-Oct-26.
+//
+
+import PythonKit
+import libpylamsupport
+
+/// Applies a Swift function to a column again and again as the column changes, eg as rows are appended, only
+/// re-running the function on the parts of the column which have changed since the last time.
+///
+/// The column is split into fixed-size chunks, and a hash of each chunk's contents is kept along with the
+/// previous results. Each `apply` hashes the column's chunks (which costs about as much as reading it) and
+/// recomputes only the chunks whose hash differs, or which are new; the results of the others are reused.
+///
+/// - Example:
+///
+///       let scores = PythonIncrementalApply { (x:Double) in expensiveScore(x) }
+///       df["score"] = scores.apply(df.x)     // computes every row
+///       // ... rows are appended to df ...
+///       df["score"] = scores.apply(df.x)     // computes just the new rows
+///
+/// Chunks are compared by a 64-bit hash of their contents, so a change which happens to leave a chunk's hash
+/// unchanged would go unnoticed; this is vanishingly unlikely by chance. `apply` must be called holding the GIL,
+/// and not from several threads at once.
+public final class PythonIncrementalApply<A: PythonBufferElement, R: PythonBufferElement> {
+    private let fn: (A) -> R
+    private let chunkSize: Int
+    private var hashes: [UInt64] = []
+    private var results: [R] = []
+
+    /// The number of chunks recomputed by the last `apply`
+    public private(set) var recomputedChunks = 0
+
+    /// - Parameters:
+    ///   - chunkSize: the number of elements in each chunk: the granularity with which changes are detected
+    ///   - fn: the function, which runs with the GIL released, and may be called from several threads at once
+    public init(chunkSize: Int = 1 << 14, _ fn: @escaping (A) -> R) {
+        precondition(chunkSize > 0, "chunkSize must be positive")
+        self.fn = fn
+        self.chunkSize = chunkSize
+    }
+
+    /// Applies the function to every element of `column`, reusing the results of the previous `apply` for chunks
+    /// which haven't changed since
+    ///
+    /// - Returns: the results, as a Series indexed like `column` if it's a Series, or otherwise as a NumPy array
+    public func apply(_ column: PythonObject) -> PythonObject {
+        let opened = PythonBuffer.requireColumn(column, of: A.self)
+        let source = opened.buffer
+        defer { source.release() }
+
+        let count = source.count
+        let previousCount = results.count
+        let chunkCount = (count + chunkSize - 1) / chunkSize
+        var newHashes = [UInt64](repeating: 0, count: chunkCount)
+        var recomputed = [Bool](repeating: false, count: chunkCount)
+
+        let fn = self.fn
+        let chunkSize = self.chunkSize
+        let hashes = self.hashes
+        results = withExtendedLifetime(opened.owner) {
+            PythonGIL.withoutGIL {
+                [R](unsafeUninitializedCapacity: count) { updated, initialised in
+                    results.withUnsafeBufferPointer { previous in
+                        if let base = updated.baseAddress, let old = previous.baseAddress {
+                            base.initialize(from: old, count: min(count, previousCount))
+                        }
+                    }
+                    newHashes.withUnsafeMutableBufferPointer { newHashes in
+                        recomputed.withUnsafeMutableBufferPointer { recomputed in
+                            PythonParallel.forEach(chunkCount) { c in
+                                let chunk = (c * chunkSize)..<min((c + 1) * chunkSize, count)
+                                newHashes[c] = PythonIncremental.hash(source, chunk, as: A.self)
+                                // a chunk is reused only if it held the same elements last time, ie lay within the
+                                // previous column (a partial last chunk included, if its length hasn't changed), and
+                                // its contents are the same
+                                guard chunk.upperBound > previousCount || c >= hashes.count || hashes[c] != newHashes[c] else { return }
+                                for i in chunk {
+                                    (updated.baseAddress! + i).initialize(to: fn(source.load(i, as: A.self)))
+                                }
+                                recomputed[c] = true
+                            }
+                        }
+                    }
+                    initialised = count
+                }
+            }
+        }
+        self.hashes = newHashes
+        recomputedChunks = recomputed.filter { $0 }.count
+
+        return PythonPandas.seriesLike(column, PythonNumpy.array(results))
+    }
+
+    /// Forgets the previous column, so that the next `apply` computes every element
+    public func reset() {
+        hashes = []
+        results = []
+    }
+}
+
+internal enum PythonIncremental {
+
+    /// A hash of the bytes of the elements in `chunk`, taken 8 bytes at a time. Can be called without the GIL.
+    static func hash<T: PythonBufferElement>(_ source: PythonBuffer, _ chunk: Range<Int>, as: T.Type) -> UInt64 {
+        let size = MemoryLayout<T>.size
+        var hash: UInt64 = 0xcbf2_9ce4_8422_2325 ^ UInt64(chunk.count)
+        for i in chunk {
+            let element = source.baseAddress + i * source.stride
+            for offset in stride(from: 0, to: size, by: 8) {
+                // an element's last word is zero-padded if its size isn't a multiple of 8
+                var word: UInt64 = 0
+                withUnsafeMutableBytes(of: &word) { word in
+                    word.copyMemory(from: UnsafeRawBufferPointer(start: element + offset, count: min(8, size - offset)))
+                }
+                hash = (hash ^ word) &* 0x9e37_79b9_7f4a_7c15
+                hash ^= hash >> 29
+            }
+        }
+        return hash
+    }
+}
@@ -0,0 +1,117 @@
+//
+//  PythonKeywordLambda.swift
+//
+//
+//  Created by strictlyswift on 17-Oct-26.
+//
+
+import PythonKit
+import libpylamsupport
+
+extension PythonLambda {
+
+    /// Creates a lambda with named parameters, which can be passed positionally or as keyword arguments.
+    ///
+    /// The function receives one `PythonObject` per parameter, in the order of `parameters`. Parameters with an
+    /// entry in `defaults` may be omitted by the caller.
+    ///
+    /// - Example:
+    ///
+    ///       let scaler = 𝝺(parameters: ["x", "scale", "offset"], defaults: ["offset": 0]) { args in
+    ///           args[0] * args[1] + args[2]
+    ///       }
+    ///       series.apply(scaler, args: [2], offset: 1)   // calls scaler(x, 2, offset=1) per element
+    ///
+    /// The lambda uses Python's `METH_FASTCALL | METH_KEYWORDS` calling convention, and the parameter names are
+    /// interned when the lambda is created, so keyword arguments are normally matched by pointer comparison.
+    public convenience init( parameters: [String],
+                             defaults: [String: PythonConvertible] = [:],
+                             _ fn: @escaping ([PythonObject]) -> PythonObject) {
+        let name = "lmb\(PythonLambda.lambdaUniqueName())"
+        let signature = PythonParameters(parameters, defaults: defaults)
+
+        let pfn: PythonFastcallFunction = { args, nargs, kwnames in
+            signature.bind(args, nargs, kwnames) { bound -> UnsafeMutablePointer<PyObject>? in
+                let result = fn((0..<signature.count).map { PythonObject(unsafe: bound[$0]!) })
+                return wrapObject(result.unsafePyObject)
+            }
+        }
+
+        self.init(backend: PythonLambdaSupport(fastcall: pfn, name: name))
+    }
+}
+
+/// The named parameters of a lambda, for binding `METH_FASTCALL | METH_KEYWORDS` arguments.
+///
+/// Names are interned once, on creation, so that they can usually be matched against the call's keyword names by
+/// pointer identity. Like the lambdas themselves, parameter lists are never freed.
+internal final class PythonParameters {
+    let count: Int
+    let names: [String]
+    private let internedNames: UnsafeMutablePointer<UnsafeMutablePointer<PyObject>?>
+    // owned references to the default values, nil for required parameters
+    private let defaults: UnsafeMutablePointer<UnsafeMutablePointer<PyObject>?>
+
+    /// Must be called holding the GIL
+    init(_ names: [String], defaults: [String: PythonConvertible] = [:]) {
+        precondition(Set(names).count == names.count, "parameter names must be unique")
+        precondition(defaults.keys.allSatisfy { names.contains($0) }, "defaults given for unknown parameters")
+
+        self.count = names.count
+        self.names = names
+        self.internedNames = .allocate(capacity: max(names.count, 1))
+        self.defaults = .allocate(capacity: max(names.count, 1))
+
+        for (i, name) in names.enumerated() {
+            internedNames[i] = internString(name)
+            if let value = defaults[name]?.pythonObject {
+                self.defaults[i] = wrapObject(value.unsafePyObject)
+            } else {
+                self.defaults[i] = nil
+            }
+        }
+    }
+
+    /// Binds the call's arguments to the parameters, then calls `body` with exactly `count` (borrowed) arguments.
+    /// Returns nil, with a Python exception set, if the arguments don't match the parameters.
+    @inline(__always)
+    func bind<R>(_ args: UnsafePointer<UnsafeMutablePointer<PyObject>?>?,
+                 _ nargs: Int,
+                 _ kwnames: UnsafeMutablePointer<PyObject>?,
+                 _ body: (UnsafePointer<UnsafeMutablePointer<PyObject>?>) -> R?) -> R? {
+        // all positional: nothing to rearrange
+        if kwnames == nil, nargs == count, let args = args {
+            return body(args)
+        }
+
+        return withArgumentSlots(count) { bound in
+            guard bindFastcallArguments(args, nargs, kwnames, internedNames, count, bound) != 0 else { return nil }
+
+            for i in 0..<count where bound[i] == nil {
+                guard let value = defaults[i] else {
+                    raisePythonError("PyExc_TypeError", "missing required argument '\(names[i])'")
+                    return nil
+                }
+                bound[i] = value
+            }
+            return body(UnsafePointer(bound))
+        }
+    }
+}
+
+/// Calls `body` with temporary storage for `count` object pointers, on the stack where there are few enough.
+@inline(__always)
+internal func withArgumentSlots<R>(_ count: Int, _ body: (UnsafeMutablePointer<UnsafeMutablePointer<PyObject>?>) -> R) -> R {
+    typealias Slot = UnsafeMutablePointer<PyObject>?
+    if count <= 8 {
+        var slots: (Slot, Slot, Slot, Slot, Slot, Slot, Slot, Slot) = (nil, nil, nil, nil, nil, nil, nil, nil)
+        return withUnsafeMutableBytes(of: &slots) { raw in
+            body(raw.baseAddress!.bindMemory(to: Slot.self, capacity: 8))
+        }
+    }
+
+    let slots = UnsafeMutablePointer<Slot>.allocate(capacity: count)
+    slots.initialize(repeating: nil, count: count)
+    defer { slots.deallocate() }
+    return body(slots)
+}
@@ -147,6 +147,7 @@ public class PythonLambda {
     private static var lambdaCounter = 0
     
     private static let lib : PythonCLibrary? = PythonCLibrary()
+    private static let registry : PythonObject? = PythonLambdaRegistry.install()
         
     public init( _ fn: @escaping (Int) -> Int) {
         let name = "lmb\(Self.lambdaUniqueName())"
@@ -341,9 +342,16 @@ public class PythonLambda {
         self.py = PythonObject(unsafe: self.backend.lambdaPointer )
     }
     
-     private static func lambdaUniqueName() -> String {
+    /// Wraps an already-constructed backend; used by the lambda shapes defined in extensions.
+    internal init( backend: PythonLambdaSupport ) {
+        self.backend = backend
+        self.py = PythonObject(unsafe: self.backend.lambdaPointer )
+    }
+    
+     internal static func lambdaUniqueName() -> String {
         // force static library to be lazily instantiated
         guard Self.lib != nil else { fatalError("Python C library not instantiated!")}
+        guard Self.registry != nil else { fatalError("Python lambda registry not installed!")}
         
         lambdaCounter += 1
          return "\(lambdaCounter)"
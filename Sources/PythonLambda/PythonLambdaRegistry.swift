@@ -0,0 +1,87 @@
+//
+//  PythonLambdaRegistry.swift
+//
+//
+//  Created by strictlyswift on 17-Oct-26.
+//
+
+import PythonKit
+import libpylamsupport
+
+/// Makes lambdas picklable, so that they can be handed to `multiprocessing` pools.
+///
+/// A lambda is pickled as a reference to its unique name, and unpickled by looking that name up in the table of
+/// Swift lambdas. A worker process created by forking inherits that table, so lambdas created *before* the pool
+/// can be unpickled there; they cannot be unpickled in a process started with `spawn` or `forkserver`, nor in a
+/// forked worker which was started before the lambda was created.
+///
+/// As `PyCFunction` objects can't carry their own `__reduce__`, the registry installs a `copyreg` reducer for
+/// builtin functions which recognises Swift lambdas, and defers to the default reduction for everything else.
+///
+/// - Example:
+///
+///       let squarer = 𝝺{(x:Int) in x*x}
+///       let pool = Python.import("multiprocessing").get_context("fork").Pool(processes: 64)
+///       let squares = pool.map(squarer, Python.range(1_000_000))
+internal enum PythonLambdaRegistry {
+    static let moduleName = "pythonlambda"
+
+    /// Work to do in a forked child process, eg discarding state belonging to threads which didn't survive the fork
+    static let afterForkInChildHandlers: [() -> Void] = [PythonGIL.resetAfterFork, resetExecutorsAfterFork]
+
+    private static func resetExecutorsAfterFork() {
+        #if compiler(>=5.5) && canImport(_Concurrency)
+        if #available(macOS 10.15, iOS 13.0, watchOS 6.0, tvOS 13.0, *) {
+            PythonExecutor.resetAllAfterFork()
+        }
+        #endif
+    }
+
+    /// Installs the `pythonlambda` module into `sys.modules`, returning it.
+    static func install() -> PythonObject {
+        let sys = Python.import("sys")
+        let existing = sys.modules.get(moduleName)
+        if existing != Python.None {
+            return existing
+        }
+
+        let module = Python.import("types").ModuleType(moduleName)
+
+        let lookup = PythonLambdaSupport({ (name: String) -> UnsafeMutableRawPointer? in
+            PythonLambdaSupport.lambdaPointerMap[name] ?? Python.None.asUnsafePointer
+        }, name: "lmbregistry_lookup")
+
+        let afterFork = PythonLambdaSupport({ (_: Int) -> Int in
+            afterForkInChildHandlers.forEach { handler in handler() }
+            return 0
+        }, name: "lmbregistry_afterfork")
+
+        module._lookup = PythonObject(unsafe: lookup.lambdaPointer)
+        module._after_fork_in_child = PythonObject(unsafe: afterFork.lambdaPointer)
+
+        Python.exec("""
+        import copyreg, os
+
+        def restore(name):
+            fn = _lookup(name)
+            if fn is None:
+                raise KeyError(f"Swift lambda {name} does not exist in this process: "
+                               "lambdas can only be unpickled in a process forked after they were created")
+            return fn
+
+        def _reduce_builtin(fn):
+            name = getattr(fn, "__self__", None)
+            if type(name) is str and _lookup(name) is fn:
+                return (restore, (name,))
+            return fn.__reduce__()
+
+        copyreg.pickle(type(len), _reduce_builtin)
+
+        if hasattr(os, "register_at_fork"):
+            os.register_at_fork(after_in_child=lambda: _after_fork_in_child(0))
+        """, module.__dict__)
+
+        sys.modules[moduleName] = module
+        return module
+    }
+}
@@ -3,7 +3,14 @@ import libpylamsupport
 let pythonCLibrary = PythonCLibrary()
 
 let METH_VARARGS  = Int32(0x0001)
+let METH_KEYWORDS = Int32(0x0002)
+let METH_FASTCALL = Int32(0x0080)
 typealias PyObjectPointer = UnsafeMutableRawPointer
+
+/// A lambda called with the `METH_FASTCALL | METH_KEYWORDS` convention: a C array of positional arguments
+/// followed by keyword argument values, their count, and a tuple of the keyword names (or nil). Returns a new
+/// reference, or nil with a Python exception set.
+typealias PythonFastcallFunction = (UnsafePointer<UnsafeMutablePointer<PyObject>?>?, Int, UnsafeMutablePointer<PyObject>?) -> UnsafeMutablePointer<PyObject>?
 /// Allows Swift functions to be represented as Python lambdas.
 ///
 /// There are a number of limitations, not least that only a limited number of function shapes are supported. These are:
@@ -50,8 +57,17 @@ public class PythonLambdaSupport {
     internal static var lambdaObjectObjectObjectObjectMap: [String:  (PyObjectPointer,PyObjectPointer,PyObjectPointer) -> PyObjectPointer] = [:]
     internal static var lambdaObjectStringMap: [String:  (PyObjectPointer) -> String] = [:]
     internal static var lambdaObjectDoubleMap: [String:  (PyObjectPointer) -> Double] = [:]
-    internal static var lambdaStringObjectMap: [String:  (String) -> PyObjectPointer] = [:]
+    internal static var lambdaStringObjectMap: [String:  (String) -> PyObjectPointer?] = [:]
     internal static var lambdaObjectIntMap: [String:  (PyObjectPointer) -> Int] = [:]
+    internal static var lambdaIntObjectMap: [String:  (Int) -> PyObjectPointer?] = [:]
+    internal static var lambdaDoubleObjectMap: [String:  (Double) -> PyObjectPointer?] = [:]
+    // batch lambdas take an input array and an optional output array, and return a new reference
+    internal static var lambdaBatchMap: [String:  (PyObjectPointer, PyObjectPointer?) -> PyObjectPointer?] = [:]
+    
+    internal static var lambdaFastcallMap: [String:  PythonFastcallFunction] = [:]
+    
+    // the Python function object for each lambda, so that it can be found again by name when unpickled
+    internal static var lambdaPointerMap: [String: PyObjectPointer] = [:]
 
     public static func initialise( withLibrary lib: UnsafeMutableRawPointer) {
         initialisePythonLibrary(lib)
@@ -260,7 +276,7 @@ public class PythonLambdaSupport {
          Self.lambdaObjectDoubleMap[name] = fn
      }
     
-    public init( _ fn: @escaping (String) -> UnsafeMutableRawPointer, name: String) {
+    public init( _ fn: @escaping (String) -> UnsafeMutableRawPointer?, name: String) {
          self.name = name
          self.methodDef = Self.methodDefFor(
              name: name,
@@ -271,8 +287,56 @@ public class PythonLambdaSupport {
          Self.lambdaStringObjectMap[name] = fn
      }
     
+    public init( _ fn: @escaping (Int) -> UnsafeMutableRawPointer?, name: String) {
+         self.name = name
+         self.methodDef = Self.methodDefFor(
+             name: name,
+             method: pyIntObjectCaller
+         )
+         self.pythonLambda = Self.lambdaBuilder(methodDefPtr: self.methodDef, name: name)
+
+         Self.lambdaIntObjectMap[name] = fn
+     }
+    
+    public init( _ fn: @escaping (Double) -> UnsafeMutableRawPointer?, name: String) {
+         self.name = name
+         self.methodDef = Self.methodDefFor(
+             name: name,
+             method: pyDoubleObjectCaller
+         )
+         self.pythonLambda = Self.lambdaBuilder(methodDefPtr: self.methodDef, name: name)
+
+         Self.lambdaDoubleObjectMap[name] = fn
+     }
+    
+    public init( batch fn: @escaping (UnsafeMutableRawPointer, UnsafeMutableRawPointer?) -> UnsafeMutableRawPointer?, name: String) {
+         self.name = name
+         self.methodDef = Self.methodDefFor(
+             name: name,
+             method: pyBatchCaller
+         )
+         self.pythonLambda = Self.lambdaBuilder(methodDefPtr: self.methodDef, name: name)
+
+         Self.lambdaBatchMap[name] = fn
+     }
+    
+    public init( fastcall fn: @escaping (UnsafePointer<UnsafeMutablePointer<PyObject>?>?, Int, UnsafeMutablePointer<PyObject>?) -> UnsafeMutablePointer<PyObject>?, name: String) {
+         self.name = name
+         // the method table only has room for the two-argument signature; METH_FASTCALL tells Python the real one
+         let fastcallCaller: @convention(c) (UnsafeMutablePointer<PyObject>?, UnsafePointer<UnsafeMutablePointer<PyObject>?>?, Int, UnsafeMutablePointer<PyObject>?) -> UnsafeMutablePointer<PyObject>? = pyFastcallCaller
+         self.methodDef = Self.methodDefFor(
+             name: name,
+             method: unsafeBitCast(fastcallCaller, to: PyCFunction.self),
+             flags: METH_FASTCALL | METH_KEYWORDS
+         )
+         self.pythonLambda = Self.lambdaBuilder(methodDefPtr: self.methodDef, name: name)
+
+         Self.lambdaFastcallMap[name] = fn
+     }
+    
     private static func methodDefFor( name: String,
-                              method: PyCFunction?) -> UnsafeMutablePointer<PyMethodDef> {
+                              method: PyCFunction?,
+                              flags: Int32 = METH_VARARGS) -> UnsafeMutablePointer<PyMethodDef> {
         // take a copy of the name so it doesn't get deallocated
         // (this then breaks certain specialist functions)
         // as per methodDef below, this is a memory leak
@@ -282,7 +346,7 @@ public class PythonLambdaSupport {
         let methodDef = PyMethodDef(
             ml_name:  nameCopy.baseAddress,
             ml_meth: method,
-            ml_flags: METH_VARARGS,
+            ml_flags: flags,
             ml_doc: nameCopy.baseAddress
         )
         
@@ -300,10 +364,12 @@ public class PythonLambdaSupport {
     }
     
     private static func lambdaBuilder( methodDefPtr: UnsafeMutablePointer<PyMethodDef>, name: String) -> PyObjectPointer {
-        name.utf8CString.withUnsafeBufferPointer { namePtr in
+        let lambda = name.utf8CString.withUnsafeBufferPointer { namePtr -> PyObjectPointer in
             let pop = createPyCFunction(methodDefPtr, getPyUnicode_FromString(namePtr.baseAddress))
             return UnsafeMutableRawPointer(pop!)
         }
+        Self.lambdaPointerMap[name] = lambda
+        return lambda
     }
 
     public var lambdaPointer: UnsafeMutableRawPointer {
@@ -335,6 +401,11 @@ public class PythonLambdaSupport {
         Self.lambdaObjectDoubleMap[self.name] = nil
         Self.lambdaStringObjectMap[self.name] = nil
         Self.lambdaObjectIntMap[self.name] = nil
+        Self.lambdaIntObjectMap[self.name] = nil
+        Self.lambdaDoubleObjectMap[self.name] = nil
+        Self.lambdaBatchMap[self.name] = nil
+        Self.lambdaFastcallMap[self.name] = nil
+        Self.lambdaPointerMap[self.name] = nil
     }
     
     deinit {
@@ -746,8 +817,50 @@ func pyStringObjectCaller(sself:UnsafeMutablePointer<PyObject>?,
         if let fn = PythonLambdaSupport.lambdaStringObjectMap[lambdaName] {
             var error = 0
             if let v = parseArgsToString(args, &error),
-                error != 0 {
-                let newV = fn(String(cString: v))
+                error != 0,
+                let newV = fn(String(cString: v)) {
+                let iPointer = wrapObject(newV.assumingMemoryBound(to: PyObject.self))
+                return iPointer
+            } else {
+                return nil
+            }
+        } else {
+            return nil
+        }
+}
+
+func pyIntObjectCaller(sself:UnsafeMutablePointer<PyObject>?,
+              args: UnsafeMutablePointer<PyObject>?)
+    -> UnsafeMutablePointer<PyObject>? {
+        guard let lambdaNamePtr = sself else { return nil }
+        let lambdaName = String(cString: stringFromPythonObject(lambdaNamePtr))
+        
+        if let fn = PythonLambdaSupport.lambdaIntObjectMap[lambdaName] {
+            var error = 0
+            let v = parseArgsToLongInt(args, &error)
+            if error != 0,
+                let newV = fn(v) {
+                let iPointer = wrapObject(newV.assumingMemoryBound(to: PyObject.self))
+                return iPointer
+            } else {
+                return nil
+            }
+        } else {
+            return nil
+        }
+}
+
+func pyDoubleObjectCaller(sself:UnsafeMutablePointer<PyObject>?,
+              args: UnsafeMutablePointer<PyObject>?)
+    -> UnsafeMutablePointer<PyObject>? {
+        guard let lambdaNamePtr = sself else { return nil }
+        let lambdaName = String(cString: stringFromPythonObject(lambdaNamePtr))
+        
+        if let fn = PythonLambdaSupport.lambdaDoubleObjectMap[lambdaName] {
+            var error = 0
+            let v = parseArgsToDouble(args, &error)
+            if error != 0,
+                let newV = fn(v) {
                 let iPointer = wrapObject(newV.assumingMemoryBound(to: PyObject.self))
                 return iPointer
             } else {
@@ -757,3 +870,41 @@ func pyStringObjectCaller(sself:UnsafeMutablePointer<PyObject>?,
             return nil
         }
 }
+
+func pyBatchCaller(sself:UnsafeMutablePointer<PyObject>?,
+              args: UnsafeMutablePointer<PyObject>?)
+    -> UnsafeMutablePointer<PyObject>? {
+        guard let lambdaNamePtr = sself else { return nil }
+        let lambdaName = String(cString: stringFromPythonObject(lambdaNamePtr))
+        
+        if let fn = PythonLambdaSupport.lambdaBatchMap[lambdaName] {
+            var error = 0
+            var output: UnsafeMutablePointer<PyObject>?
+            if let input = parseArgsToObjectAndOptionalObject(args, &output, &error),
+                error != 0,
+                let result = fn(input, output) {
+                // already a new reference
+                return result.assumingMemoryBound(to: PyObject.self)
+            } else {
+                return nil
+            }
+        } else {
+            return nil
+        }
+}
+
+func pyFastcallCaller(sself:UnsafeMutablePointer<PyObject>?,
+              args: UnsafePointer<UnsafeMutablePointer<PyObject>?>?,
+              nargs: Int,
+              kwnames: UnsafeMutablePointer<PyObject>?)
+    -> UnsafeMutablePointer<PyObject>? {
+        guard let lambdaNamePtr = sself else { return nil }
+        let lambdaName = String(cString: stringFromPythonObject(lambdaNamePtr))
+        
+        if let fn = PythonLambdaSupport.lambdaFastcallMap[lambdaName] {
+            // already a new reference
+            return fn(args, nargs, kwnames)
+        } else {
+            return nil
+        }
+}
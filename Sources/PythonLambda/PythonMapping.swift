@@ -0,0 +1,162 @@
+//
+//  PythonMapping.swift
+//
+//
+//  Created by strictlyswift on 17-Oct-26.
+//
+
+import PythonKit
+import libpylamsupport
+
+/// A Swift dictionary exposed to Python as a read-only mapping, supporting `m[key]`, `key in m`, `m.get(key, default)`,
+/// `len` and iteration; and `keys()`, `values()` and `items()`, which return lists, so `dict(m)` works. It isn't a
+/// `collections.abc.Mapping`: it has none of that ABC's views or equality.
+///
+/// The keys and values are boxed once, when the mapping is created, so looking a key up creates no Python objects
+/// and calls no Swift closures: it's a native hash lookup of the key. `String` keys are looked up by their UTF-8
+/// bytes, which Python holds directly for ASCII strings, so no Swift `String` is created for them either.
+///
+/// To look up a whole column at once, use `lookup(_:default:)`, which is also available to Python as
+/// `m.lookup(keys, default=None)` (returning a list).
+///
+/// - Example:
+///
+///       let codes = PythonMapping(regionCodes)          // eg a [String: Int]
+///       df["code"] = codes.lookup(df.region, default: -1)
+///
+/// Must be created holding the GIL.
+public final class PythonMapping<K: PythonLambdaArgument & PythonLambdaResult & Hashable, V: PythonLambdaResult>: PythonConvertible {
+    public let pythonObject: PythonObject
+
+    public init(_ dictionary: [K: V]) {
+        let entries = Array(dictionary)
+        let keys = entries.map { $0.key }
+        let index: PythonMappingIndex
+        if let strings = keys as? [String] {
+            index = PythonStringMappingIndex(strings)
+        } else {
+            index = PythonHashableMappingIndex(keys)
+        }
+
+        let boxedKeys = PythonMappingIndex.tuple(keys.map { $0.boxed() })
+        let boxedValues = PythonMappingIndex.tuple(entries.map { $0.value.boxed() })
+        let storage = Unmanaged.passRetained(index).toOpaque()
+        guard let mapping = newSwiftMapping(storage, PythonMappingIndex.findCallback, PythonMappingIndex.releaseCallback,
+                                            boxedKeys.unsafePyObject, boxedValues.unsafePyObject) else {
+            Unmanaged<PythonMappingIndex>.fromOpaque(storage).release()
+            clearPythonError()
+            fatalError("could not create a Python mapping")
+        }
+        defer { decRef(mapping) }
+        pythonObject = PythonObject(unsafe: UnsafeMutableRawPointer(mapping))
+    }
+
+    /// The value for each key in `column`, or `fallback` where a key is missing
+    ///
+    /// - Returns: a Series indexed like `column`, if it's a Series, or else a list
+    public func lookup(_ column: PythonObject, default fallback: PythonConvertible = Python.None) -> PythonObject {
+        PythonPandas.seriesLike(column, pythonObject.lookup(column, fallback))
+    }
+}
+
+/// Finds the position of a key among a mapping's keys, without holding any Python objects
+internal class PythonMappingIndex {
+    /// The position of the key, or -1 if it isn't present or isn't of the key type. Called holding the GIL.
+    func find(_ key: UnsafeMutablePointer<PyObject>) -> Int { -1 }
+
+    static let findCallback: MappingFindFunction = { storage, key in
+        Unmanaged<PythonMappingIndex>.fromOpaque(storage!).takeUnretainedValue().find(key!)
+    }
+
+    static let releaseCallback: MappingReleaseFunction = { storage in
+        Unmanaged<PythonMappingIndex>.fromOpaque(storage!).release()
+    }
+
+    /// A tuple of boxed values
+    static func tuple(_ boxed: [UnsafeMutableRawPointer?]) -> PythonObject {
+        var items = boxed.map { $0?.assumingMemoryBound(to: PyObject.self) }
+        guard let tuple = packTuple(&items, items.count) else {
+            clearPythonError()
+            fatalError("could not box the keys and values of a Python mapping")
+        }
+        defer { decRef(tuple) }
+        return PythonObject(unsafe: UnsafeMutableRawPointer(tuple))
+    }
+}
+
+/// Finds keys with a Swift dictionary from each key to its position
+internal final class PythonHashableMappingIndex<K: PythonLambdaArgument & Hashable>: PythonMappingIndex {
+    private let positions: [K: Int]
+
+    init(_ keys: [K]) {
+        positions = Dictionary(uniqueKeysWithValues: zip(keys, keys.indices))
+    }
+
+    override func find(_ key: UnsafeMutablePointer<PyObject>) -> Int {
+        guard let key = K.unboxed(from: UnsafeMutableRawPointer(key)) else {
+            clearPythonError()
+            return -1
+        }
+        return positions[key] ?? -1
+    }
+}
+
+/// Finds string keys by their UTF-8 bytes, in an open-addressed hash table over one contiguous copy of all the keys'
+/// bytes, so that lookups needn't create a `String`
+internal final class PythonStringMappingIndex: PythonMappingIndex {
+    private var bytes: [UInt8] = []
+    /// Key `i`'s bytes are `bytes[starts[i]..<starts[i + 1]]`
+    private var starts: [Int] = [0]
+    /// The position of a key in each slot, or -1 for an empty slot
+    private var slots: [Int]
+    private let mask: Int
+
+    init(_ keys: [String]) {
+        var capacity = 8
+        while capacity < keys.count * 2 {
+            capacity *= 2
+        }
+        slots = [Int](repeating: -1, count: capacity)
+        mask = capacity - 1
+        super.init()
+
+        for (position, key) in keys.enumerated() {
+            bytes.append(contentsOf: key.utf8)
+            starts.append(bytes.count)
+            var slot = slotFor(hash: Array(key.utf8).withUnsafeBytes(Self.hash))
+            while slots[slot] >= 0 {
+                slot = (slot + 1) & mask
+            }
+            slots[slot] = position
+        }
+    }
+
+    override func find(_ key: UnsafeMutablePointer<PyObject>) -> Int {
+        var length: CLong = 0
+        guard let utf8 = unboxString(key, &length) else {
+            clearPythonError()
+            return -1
+        }
+        let key = UnsafeRawBufferPointer(start: utf8, count: Int(length))
+        return bytes.withUnsafeBytes { bytes in
+            var slot = slotFor(hash: Self.hash(key))
+            while slots[slot] >= 0 {
+                let position = slots[slot]
+                let candidate = UnsafeRawBufferPointer(rebasing: bytes[starts[position]..<starts[position + 1]])
+                if candidate.elementsEqual(key) {
+                    return position
+                }
+                slot = (slot + 1) & mask
+            }
+            return -1
+        }
+    }
+
+    private func slotFor(hash: Int) -> Int { hash & mask }
+
+    private static func hash(_ key: UnsafeRawBufferPointer) -> Int {
+        var hasher = Hasher()
+        hasher.combine(bytes: key)
+        return hasher.finalize()
+    }
+}
@@ -0,0 +1,40 @@
+//
+//  PythonParallel.swift
+//
+//
+//  Created by strictlyswift on 17-Oct-26.
+//
+
+import Foundation
+
+/// Splits array work across cores. The work must not use any `PythonObject`s, and should normally run with the
+/// GIL released.
+internal enum PythonParallel {
+    /// The number of pieces to split work into
+    static let concurrency = max(ProcessInfo.processInfo.activeProcessorCount, 1)
+
+    /// Splits `0..<count` into contiguous ranges, each of at least `minimumChunk` (except possibly the last), and
+    /// runs `body` over them concurrently. Returns once every range is done.
+    static func forEachRange(_ count: Int, minimumChunk: Int = 1, _ body: (Range<Int>) -> Void) {
+        let chunks = ranges(count, pieces: concurrency, minimumChunk: minimumChunk)
+        if chunks.count <= 1 {
+            chunks.forEach(body)
+            return
+        }
+        DispatchQueue.concurrentPerform(iterations: chunks.count) { i in
+            body(chunks[i])
+        }
+    }
+
+    /// Runs `body` for each of `0..<iterations` concurrently, returning once all are done
+    static func forEach(_ iterations: Int, _ body: (Int) -> Void) {
+        DispatchQueue.concurrentPerform(iterations: iterations, execute: body)
+    }
+
+    /// `0..<count` split into at most `pieces` near-equal contiguous ranges, each of at least `minimumChunk`
+    static func ranges(_ count: Int, pieces: Int, minimumChunk: Int = 1) -> [Range<Int>] {
+        guard count > 0 else { return [] }
+        let n = max(1, min(pieces, count / max(minimumChunk, 1)))
+        return (0..<n).map { i in (i * count / n)..<((i + 1) * count / n) }
+    }
+}
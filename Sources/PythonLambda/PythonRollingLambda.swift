@@ -0,0 +1,145 @@
+//
+//  PythonRollingLambda.swift
+//
+//
+//  Created by strictlyswift on 17-Oct-26.
+//
+
+import PythonKit
+import libpylamsupport
+
+/// A statistic over a rolling window, maintained incrementally as values enter and leave the window, so that a
+/// rolling computation over N values costs O(N) rather than O(N × window).
+///
+/// - Example:
+///
+///       struct RollingMean: PythonRollingLambda {
+///           var sum = 0.0, count = 0
+///           mutating func add(_ value: Double) { sum += value; count += 1 }
+///           mutating func remove(_ value: Double) { sum -= value; count -= 1 }
+///           func value() -> Double { sum / Double(count) }
+///       }
+///       df["mean20"] = RollingMean().rolling(df.x, window: 20)
+///       df["mean5m"] = RollingMean().rolling(df.x, window: .minutes(5), times: df.time)
+///
+/// As with pandas' `rolling`, NaN values are skipped: they're never added, and don't count towards `minPeriods`.
+/// The statistic runs with the GIL released, so must not use any `PythonObject`s.
+public protocol PythonRollingLambda {
+    /// A value enters the window
+    mutating func add(_ value: Double)
+    /// A value, previously added, leaves the window
+    mutating func remove(_ value: Double)
+    /// The statistic over the values currently in the window
+    func value() -> Double
+}
+
+extension PythonRollingLambda {
+
+    /// The statistic over each window of `window` consecutive values of `column`, starting from this (normally
+    /// empty) state, like `column.rolling(window).apply(...)`.
+    ///
+    /// - Parameters:
+    ///   - minPeriods: the number of (non-NaN) values needed in a window for a result; fewer give NaN. Defaults to
+    ///     `window`.
+    /// - Returns: a Series with the same index as `column`, if it's a Series, or else a NumPy array
+    public func rolling(_ column: PythonObject, window: Int, minPeriods: Int? = nil) -> PythonObject {
+        precondition(window > 0, "window must be positive")
+        let minPeriods = minPeriods ?? window
+
+        return PythonRolling.drive(column) { values, results in
+            var state = self
+            var observations = 0
+            for i in 0..<values.count {
+                if !values[i].isNaN {
+                    state.add(values[i])
+                    observations += 1
+                }
+                if i >= window, !values[i - window].isNaN {
+                    state.remove(values[i - window])
+                    observations -= 1
+                }
+                results[i] = observations >= minPeriods ? state.value() : .nan
+            }
+        }
+    }
+
+    /// The statistic over each window of values of `column` timed within `window` of the current value's time, ie
+    /// those with times in `(t - window, t]`, like `column.rolling("5min", on: times).apply(...)`.
+    ///
+    /// - Parameters:
+    ///   - times: the time of each value, which must be in increasing order. Unlike pandas, which rejects them,
+    ///     NaT times are allowed: those rows are skipped, and their results are NaN.
+    ///   - minPeriods: the number of (non-NaN) values needed in a window for a result; fewer give NaN
+    /// - Returns: a Series with the same index as `column`, if it's a Series, or else a NumPy array
+    public func rolling(_ column: PythonObject, window: PythonDuration, times: PythonObject, minPeriods: Int = 1) -> PythonObject {
+        precondition(window.nanoseconds > 0, "window must be positive")
+        let opened = PythonBuffer.requireColumn(times, of: PythonInstant.self)
+        defer { opened.buffer.release() }
+        let instants = StridedBufferView<PythonInstant>(opened.buffer)
+
+        return withExtendedLifetime(opened.owner) {
+            PythonRolling.drive(column) { values, results in
+                precondition(instants.count == values.count, "times and column must be the same length")
+                var state = self
+                var observations = 0
+                var start = 0
+                var latest: PythonInstant? = nil
+                for i in 0..<values.count {
+                    // a row without a time is never added, and its result is left as NaN
+                    guard !instants[i].isNotATime else { continue }
+                    if let latest = latest {
+                        precondition(instants[i] >= latest, "times must be in increasing order")
+                    }
+                    latest = instants[i]
+                    if !values[i].isNaN {
+                        state.add(values[i])
+                        observations += 1
+                    }
+                    // nothing can be timed at or before a cutoff earlier than the earliest representable time
+                    let (cutoff, overflow) = instants[i].nanoseconds.subtractingReportingOverflow(window.nanoseconds)
+                    while !overflow && (instants[start].isNotATime || instants[start].nanoseconds <= cutoff) {
+                        if !instants[start].isNotATime && !values[start].isNaN {
+                            state.remove(values[start])
+                            observations -= 1
+                        }
+                        start += 1
+                    }
+                    results[i] = observations >= minPeriods ? state.value() : .nan
+                }
+            }
+        }
+    }
+}
+
+internal enum PythonRolling {
+
+    /// Runs `body` over `column`'s values, read in place without the GIL, to fill in a result for each, returning
+    /// the results as a Series indexed like `column` (if it's a Series) or as a NumPy array
+    static func drive(_ column: PythonObject, _ body: (StridedBufferView<Double>, UnsafeMutableBufferPointer<Double>) -> Void) -> PythonObject {
+        let opened = PythonBuffer.requireColumn(column, of: Double.self)
+        let source = opened.buffer
+        defer { source.release() }
+
+        let result = PythonNumpy.empty(source.count, of: Double.self)
+        let target = PythonBuffer.output(result, of: Double.self, count: source.count)!
+        defer { target.release() }
+
+        withExtendedLifetime(opened.owner) {
+            PythonGIL.withoutGIL {
+                // a new array is contiguous
+                let results = UnsafeMutableBufferPointer(start: target.baseAddress.assumingMemoryBound(to: Double.self), count: source.count)
+                results.initialize(repeating: .nan)
+                body(StridedBufferView(source), results)
+            }
+        }
+
+        return PythonPandas.seriesLike(column, result)
+    }
+}
+
+extension StridedBufferView {
+    /// A view of a one-dimensional buffer's elements, valid until the buffer is released
+    init(_ buffer: PythonBuffer) {
+        self.init(base: buffer.baseAddress, count: buffer.count, stride: buffer.stride)
+    }
+}
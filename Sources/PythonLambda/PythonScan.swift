@@ -0,0 +1,117 @@
+//
+//  PythonScan.swift
+//
+//
+//  Created by strictlyswift on 17-Oct-26.
+//
+
+import PythonKit
+import libpylamsupport
+
+extension PythonLambda {
+
+    /// Computes the cumulative combination (prefix scan) of a column with an associative Swift function, like
+    /// `cumsum` but for any combiner, eg a capped sum or a running maximum.
+    ///
+    /// An inclusive scan gives `x[0], x[0]•x[1], x[0]•x[1]•x[2], ...`; an exclusive scan starts from `identity`
+    /// instead, giving `identity, x[0], x[0]•x[1], ...`.
+    ///
+    /// Large columns are scanned in parallel with a blocked algorithm: each core scans its own block of the column,
+    /// the block totals are combined in order, and then each block's results are combined with the total of the
+    /// blocks before it. This relies on `combine` being associative; it needn't be commutative.
+    ///
+    /// - Example:
+    ///
+    ///       let runningMax = PythonLambda.scan(df.price) { (a:Double, b:Double) in max(a, b) }
+    ///       let before = PythonLambda.scan(df.qty, exclusive: true, identity: 0) { (a:Int, b:Int) in a + b }
+    ///
+    /// - Parameters:
+    ///   - column: the values to scan, as any array-like
+    ///   - exclusive: whether to scan exclusively, in which case `identity` is required
+    ///   - identity: the identity of `combine`, eg 0 for addition
+    ///   - output: an existing array to write the results into, rather than a new one
+    ///   - combine: the associative function, which runs with the GIL released, and may be called from several
+    ///     threads at once
+    /// - Returns: the results, as a Series indexed like `column` if it's a Series, or otherwise as a NumPy array
+    ///   (`output`, if given)
+    public static func scan<T: PythonBufferElement>(_ column: PythonObject,
+                                                    exclusive: Bool = false,
+                                                    identity: T? = nil,
+                                                    into output: PythonObject? = nil,
+                                                    _ combine: (T, T) -> T) -> PythonObject {
+        precondition(!exclusive || identity != nil, "an exclusive scan needs an identity")
+
+        let opened = PythonBuffer.requireColumn(column, of: T.self)
+        let source = opened.buffer
+        defer { source.release() }
+
+        let result = output ?? PythonNumpy.empty(source.count, of: T.self)
+        guard let target = PythonBuffer.output(result, of: T.self, count: source.count) else {
+            clearPythonError()
+            fatalError("output must be a writable one-dimensional array of \(source.count) \(T.numpyDType)")
+        }
+        defer { target.release() }
+
+        withExtendedLifetime(opened.owner) {
+            PythonGIL.withoutGIL {
+                PythonScan.scan(source, into: target, exclusive: exclusive, identity: identity, combine)
+            }
+        }
+
+        return output ?? PythonPandas.seriesLike(column, result)
+    }
+}
+
+internal enum PythonScan {
+    /// Below this many elements per block, a parallel scan isn't worth its second pass
+    static let minimumBlock = 1 << 15
+
+    /// Scans `source` into `target`, in parallel blocks if it's large enough. Can be called without the GIL.
+    static func scan<T>(_ source: PythonBuffer, into target: PythonBuffer, exclusive: Bool, identity: T?, _ combine: (T, T) -> T) {
+        let blocks = PythonParallel.ranges(source.count, pieces: PythonParallel.concurrency, minimumChunk: minimumBlock)
+        guard blocks.count > 1 else {
+            _ = scanBlock(source, into: target, blocks.first ?? 0..<0, exclusive: exclusive, identity: identity, combine)
+            return
+        }
+
+        // 1. scan each block independently, keeping its total
+        var totals = [T?](repeating: nil, count: blocks.count)
+        totals.withUnsafeMutableBufferPointer { totals in
+            PythonParallel.forEach(blocks.count) { b in
+                totals[b] = scanBlock(source, into: target, blocks[b], exclusive: exclusive, identity: identity, combine)
+            }
+        }
+
+        // 2. the combined total of all the blocks before each block
+        var carries = [T?](repeating: nil, count: blocks.count)
+        for b in 1..<blocks.count {
+            carries[b] = carries[b - 1].map { combine($0, totals[b - 1]!) } ?? totals[b - 1]
+        }
+
+        // 3. fold each block's carry into its results
+        PythonParallel.forEach(blocks.count - 1) { i in
+            let b = i + 1
+            let carry = carries[b]!
+            for index in blocks[b] {
+                target.store(combine(carry, target.load(index, as: T.self)), at: index)
+            }
+        }
+    }
+
+    /// Scans one block on its own, returning the combination of all its elements (nil if it's empty)
+    private static func scanBlock<T>(_ source: PythonBuffer, into target: PythonBuffer, _ block: Range<Int>,
+                                     exclusive: Bool, identity: T?, _ combine: (T, T) -> T) -> T? {
+        var running: T? = exclusive ? identity : nil
+        for index in block {
+            let value = source.load(index, as: T.self)
+            if exclusive {
+                target.store(running!, at: index)
+                running = combine(running!, value)
+            } else {
+                running = running.map { combine($0, value) } ?? value
+                target.store(running!, at: index)
+            }
+        }
+        return running
+    }
+}
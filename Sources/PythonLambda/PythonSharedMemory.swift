@@ -0,0 +1,103 @@
+//
+//  PythonSharedMemory.swift
+//
+//
+//  Created by strictlyswift on 17-Oct-26.
+//
+
+import PythonKit
+
+extension PythonLambda {
+
+    /// Applies a Swift function to every element of a column using a pool of forked worker processes, without
+    /// pickling the data.
+    ///
+    /// The column is copied once into a `multiprocessing.shared_memory` segment, and the output is preallocated in
+    /// another. Each worker attaches to both segments and runs a batch lambda (see `init(batch:)`) over its own
+    /// slice, so only the segment names and slice bounds cross process boundaries. The output is copied into an
+    /// ordinary NumPy array, and both segments are freed, before returning.
+    ///
+    /// - Example:
+    ///
+    ///       let scores = PythonLambda.applyInProcesses({(x:Double) in expensiveScore(x)}, to: df.x, processes: 8)
+    ///
+    /// - Parameters:
+    ///   - fn: the function to apply to each element
+    ///   - column: a one-dimensional array-like of `A`, eg a NumPy array or pandas Series
+    ///   - processes: the number of worker processes
+    ///   - chunksPerProcess: the column is split into `processes * chunksPerProcess` slices, to balance the load
+    ///
+    /// - Note: workers are forked (the `fork` start method), so this is not available on Windows. A new pool is
+    /// started for each call, as workers must be forked after the lambda is created.
+    public static func applyInProcesses<A: PythonBufferElement, R: PythonBufferElement>(_ fn: @escaping (A) -> R,
+                                                                                       to column: PythonObject,
+                                                                                       processes: Int,
+                                                                                       chunksPerProcess: Int = 4) -> PythonObject {
+        precondition(processes > 0 && chunksPerProcess > 0, "processes and chunksPerProcess must be positive")
+
+        let lambda = PythonLambda(batch: fn)
+        defer { lambda.dealloc() }
+
+        return PythonSharedMemory.helpers.shared_apply(lambda, column, A.numpyDType, R.numpyDType,
+                                                       processes, processes * chunksPerProcess)
+    }
+}
+
+internal enum PythonSharedMemory {
+
+    // defined in the pythonlambda module, so that forked workers can unpickle a reference to the slice function
+    static let helpers: PythonObject = {
+        let module = Python.import(PythonLambdaRegistry.moduleName)
+        Python.exec("""
+        def _apply_slice(fn, in_name, in_dtype, out_name, out_dtype, n, start, stop):
+            import numpy as np
+            from multiprocessing import shared_memory
+            source = shared_memory.SharedMemory(name=in_name)
+            target = shared_memory.SharedMemory(name=out_name)
+            try:
+                xs = np.ndarray((n,), dtype=in_dtype, buffer=source.buf)
+                ys = np.ndarray((n,), dtype=out_dtype, buffer=target.buf)
+                fn(xs[start:stop], ys[start:stop])
+                del xs, ys
+            finally:
+                source.close()
+                target.close()
+
+        def shared_apply(fn, column, in_dtype, out_dtype, processes, chunks):
+            import multiprocessing
+            import numpy as np
+            from multiprocessing import shared_memory
+
+            xs = np.ascontiguousarray(column, dtype=in_dtype)
+            n = len(xs)
+            out_size = n * np.dtype(out_dtype).itemsize
+            source = shared_memory.SharedMemory(create=True, size=max(xs.nbytes, 1))
+            target = shared_memory.SharedMemory(create=True, size=max(out_size, 1))
+            try:
+                staged = np.ndarray((n,), dtype=in_dtype, buffer=source.buf)
+                staged[:] = xs
+                del staged
+
+                bounds = [(i * n) // chunks for i in range(chunks + 1)]
+                slices = [(fn, source.name, in_dtype, target.name, out_dtype, n, start, stop)
+                          for start, stop in zip(bounds, bounds[1:]) if start < stop]
+                with multiprocessing.get_context("fork").Pool(processes) as pool:
+                    pool.starmap(_apply_slice, slices)
+            except BaseException:
+                target.close()
+                target.unlink()
+                raise
+            finally:
+                source.close()
+                source.unlink()
+
+            try:
+                ys = np.frombuffer(target.buf, dtype=out_dtype, count=n).copy()
+            finally:
+                target.close()
+                target.unlink()
+            return ys
+        """, module.__dict__)
+        return module
+    }()
+}
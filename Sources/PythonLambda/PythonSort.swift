@@ -0,0 +1,131 @@
+//
+//  PythonSort.swift
+//
+//
+//  Created by strictlyswift on 17-Oct-26.
+//
+
+import PythonKit
+import libpylamsupport
+
+extension PythonLambda {
+
+    /// Sorts a Python sequence by a Swift key function, like `sorted(xs, key=𝝺{...})` but without any Python
+    /// comparisons: every key is computed in Swift into one array, the indices are sorted natively (in parallel
+    /// for large sequences), and the sorted list is built in a single pass.
+    ///
+    /// - Example:
+    ///
+    ///       let byLength = PythonLambda.sorted(names, key: {(s:String) in s.count})
+    ///
+    /// - Parameters:
+    ///   - sequence: any iterable whose elements convert to `A`
+    ///   - key: computes each element's sort key; it runs with the GIL released
+    ///   - reverse: whether to sort in descending order of key
+    /// - Returns: a new list. As with `sorted`, the sort is stable.
+    public static func sorted<A: PythonLambdaArgument, K: Comparable>(_ sequence: PythonObject,
+                                                                       key: (A) -> K,
+                                                                       reverse: Bool = false) -> PythonObject {
+        let list = Python.list(sequence)
+        let order = PythonSort.order(A.unboxedList(list), key: key, reverse: reverse)
+
+        return withExtendedLifetime(list) {
+            order.withUnsafeBufferPointer { order -> PythonObject in
+                let sorted = listInOrder(list.unsafePyObject, order.baseAddress, order.count)!
+                defer { decRef(sorted) }
+                return PythonObject(unsafe: UnsafeMutableRawPointer(sorted))
+            }
+        }
+    }
+
+    /// The indices which would sort a Python sequence by a Swift key function, as a NumPy array, like
+    /// `numpy.argsort(keys, kind="stable")` over the keys. See `sorted(_:key:reverse:)`.
+    ///
+    /// - Example:
+    ///
+    ///       let order = PythonLambda.argsort(df.name, key: {(s:String) in s.lowercased()})
+    ///       let reordered = df.iloc[order]
+    public static func argsort<A: PythonLambdaArgument, K: Comparable>(_ sequence: PythonObject,
+                                                                        key: (A) -> K,
+                                                                        reverse: Bool = false) -> PythonObject {
+        PythonNumpy.array(PythonSort.order(A.unboxedColumn(sequence), key: key, reverse: reverse))
+    }
+}
+
+internal enum PythonSort {
+    /// Below this many elements per core, sorting isn't split across cores
+    static let minimumRun = 1 << 14
+
+    /// The stable sort order of `arguments` by `key`. Must be called holding the GIL, which it releases meanwhile.
+    static func order<A, K: Comparable>(_ arguments: [A], key: (A) -> K, reverse: Bool) -> [Int] {
+        PythonGIL.withoutGIL {
+            let keys = arguments.map(key)
+            // ties are broken by position, so the order is stable whichever algorithm sorts it
+            let precedes: (Int, Int) -> Bool = reverse
+                ? { a, b in keys[a] > keys[b] || (keys[a] == keys[b] && a < b) }
+                : { a, b in keys[a] < keys[b] || (keys[a] == keys[b] && a < b) }
+            return mergeSorted(keys.count, by: precedes)
+        }
+    }
+
+    /// `0..<count` sorted by `precedes`: each core sorts its own run, then runs are merged pairwise, with the
+    /// pairs at each level merged concurrently
+    static func mergeSorted(_ count: Int, by precedes: (Int, Int) -> Bool) -> [Int] {
+        var order = Array(0..<count)
+        var runs = PythonParallel.ranges(count, pieces: PythonParallel.concurrency, minimumChunk: minimumRun)
+        guard runs.count > 1 else {
+            order.sort(by: precedes)
+            return order
+        }
+
+        var scratch = order
+        order.withUnsafeMutableBufferPointer { order in
+            scratch.withUnsafeMutableBufferPointer { scratch in
+                PythonParallel.forEach(runs.count) { r in
+                    var run = UnsafeMutableBufferPointer(rebasing: order[runs[r]])
+                    run.sort(by: precedes)
+                }
+
+                var source = order
+                var target = scratch
+                while runs.count > 1 {
+                    let pairs = (runs.count + 1) / 2
+                    let merged = (0..<pairs).map { p in
+                        runs[2 * p].lowerBound..<(2 * p + 1 < runs.count ? runs[2 * p + 1].upperBound : runs[2 * p].upperBound)
+                    }
+                    PythonParallel.forEach(pairs) { p in
+                        if 2 * p + 1 < runs.count {
+                            merge(source, runs[2 * p], runs[2 * p + 1], into: target, by: precedes)
+                        } else {
+                            // an odd run out is carried up to the next level unchanged
+                            for i in runs[2 * p] { target[i] = source[i] }
+                        }
+                    }
+                    runs = merged
+                    swap(&source, &target)
+                }
+                if source.baseAddress != order.baseAddress {
+                    for i in 0..<count { order[i] = source[i] }
+                }
+            }
+        }
+        return order
+    }
+
+    /// Merges the adjacent sorted runs `left` and `right` of `source` into the same positions of `target`
+    private static func merge(_ source: UnsafeMutableBufferPointer<Int>, _ left: Range<Int>, _ right: Range<Int>,
+                              into target: UnsafeMutableBufferPointer<Int>, by precedes: (Int, Int) -> Bool) {
+        var l = left.lowerBound
+        var r = right.lowerBound
+        for i in left.lowerBound..<right.upperBound {
+            // take from the left run on ties, keeping the merge stable
+            if r == right.upperBound || (l < left.upperBound && !precedes(source[r], source[l])) {
+                target[i] = source[l]
+                l += 1
+            } else {
+                target[i] = source[r]
+                r += 1
+            }
+        }
+    }
+}
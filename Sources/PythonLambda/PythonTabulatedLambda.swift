@@ -0,0 +1,147 @@
+//
+//  PythonTabulatedLambda.swift
+//
+//
+//  Created by strictlyswift on 17-Oct-26.
+//
+
+import PythonKit
+import libpylamsupport
+
+/// Argument types with few enough values that a lambda over them can be evaluated for every one of them up front
+public protocol PythonTabulatedArgument: PythonLambdaArgument {
+    /// Every value of the type, in table order
+    static var tabulatedDomain: [Self] { get }
+    /// The value's position in `tabulatedDomain`
+    var tableIndex: Int { get }
+}
+
+extension Bool: PythonTabulatedArgument {
+    public static var tabulatedDomain: [Bool] { [false, true] }
+    public var tableIndex: Int { self ? 1 : 0 }
+}
+
+extension UInt8: PythonTabulatedArgument {
+    public static var tabulatedDomain: [UInt8] { Array(0...UInt8.max) }
+    public var tableIndex: Int { Int(self) }
+}
+
+extension PythonLambda {
+
+    /// The most integers a tabulated lambda's `domain` may span, so that its table stays small
+    public static let maximumTabulatedDomain = 1 << 16
+
+    /// Whether `domain` is small enough for a tabulated lambda, ie spans at most `maximumTabulatedDomain` integers
+    public static func canTabulate(_ domain: ClosedRange<Int>) -> Bool {
+        let (span, overflow) = domain.upperBound.subtractingReportingOverflow(domain.lowerBound)
+        return !overflow && span < maximumTabulatedDomain
+    }
+
+    /// Creates a *tabulated* lambda, which evaluates `fn` once for every value of its argument type, when it's
+    /// created, and boxes the results. Each call then just looks its result up in the table, without calling Swift
+    /// or boxing anything.
+    ///
+    /// - Example:
+    ///
+    ///       let label = 𝝺(tabulating: {(flag:Bool) in flag ? "yes" : "no"})
+    ///       let level = 𝝺(tabulating: {(x:UInt8) in pow(Double(x) / 255, 2.2)})
+    ///
+    /// - Note: `fn` is only called while the lambda is created, so must have no side effects which later calls
+    ///   would need.
+    public convenience init<A: PythonTabulatedArgument, R: PythonLambdaResult>(tabulating fn: (A) -> R) {
+        let table = PythonTabulation.boxed(A.tabulatedDomain.map(fn))
+        let pfn: PythonFastcallFunction = { args, nargs, kwnames in
+            guard let args = PythonTypedArguments.positional(args, nargs, kwnames, count: 1),
+                let a = A.unboxed(from: args[0]!) else { return nil }
+            return PythonTabulation.result(table[a.tableIndex])
+        }
+        self.init(backend: PythonLambdaSupport(fastcall: pfn, name: "lmb\(PythonLambda.lambdaUniqueName())"))
+    }
+
+    /// Creates a tabulated lambda over the integers in `domain`, which evaluates `fn` once for each of them when it's
+    /// created. Calling it with an integer outside `domain` raises a `ValueError`. It's a fatal error if `domain`
+    /// spans more than `maximumTabulatedDomain` integers.
+    ///
+    /// - Example:
+    ///
+    ///       let weekday = 𝝺(tabulating: {(d:Int) in names[d]}, domain: 0...6)
+    public convenience init<R: PythonLambdaResult>(tabulating fn: (Int) -> R, domain: ClosedRange<Int>) {
+        precondition(PythonLambda.canTabulate(domain), "domain is too large to tabulate")
+        let table = PythonTabulation.boxed(domain.map(fn))
+        let pfn: PythonFastcallFunction = { args, nargs, kwnames in
+            guard let args = PythonTypedArguments.positional(args, nargs, kwnames, count: 1),
+                let a = Int.unboxed(from: args[0]!) else { return nil }
+            guard domain.contains(a) else {
+                raisePythonError("PyExc_ValueError", "\(a) is outside the lambda's domain \(domain)")
+                return nil
+            }
+            return PythonTabulation.result(table[a - domain.lowerBound])
+        }
+        self.init(backend: PythonLambdaSupport(fastcall: pfn, name: "lmb\(PythonLambda.lambdaUniqueName())"))
+    }
+
+    /// Creates a tabulated *batch* lambda: `fn` is evaluated once for every value of its argument type, when it's
+    /// created, and applying the lambda to an array then just looks each element's result up in the table. See
+    /// `init(batch:)`.
+    ///
+    /// - Example:
+    ///
+    ///       let level = 𝝺(batchTabulating: {(x:UInt8) in pow(Double(x) / 255, 2.2)})
+    ///       let levels = level.pythonObject(image.ravel())
+    public convenience init<A: PythonTabulatedArgument & PythonBufferElement, R: PythonBufferElement>(batchTabulating fn: (A) -> R) {
+        let table = A.tabulatedDomain.map(fn)
+        let pfn = { (input: PyObjectPointer, output: PyObjectPointer?) in
+            PythonBatch.map({ (a: A) in table[a.tableIndex] }, input: PythonObject(unsafe: input), output: output.map { PythonObject(unsafe: $0) })
+        }
+        self.init(backend: PythonLambdaSupport(batch: pfn, name: "lmb\(PythonLambda.lambdaUniqueName())"))
+    }
+
+    /// Creates a tabulated batch lambda over the integers in `domain`. Applying it to an array with any element
+    /// outside `domain` raises a `ValueError`. As with `init(tabulating:domain:)`, `domain` may span at most
+    /// `maximumTabulatedDomain` integers.
+    public convenience init<R: PythonBufferElement>(batchTabulating fn: (Int) -> R, domain: ClosedRange<Int>) {
+        precondition(PythonLambda.canTabulate(domain), "domain is too large to tabulate")
+        let table = domain.map(fn)
+        let pfn = { (input: PyObjectPointer, output: PyObjectPointer?) -> PyObjectPointer? in
+            var outside: Int? = nil
+            let result = PythonBatch.map({ (a: Int) -> R in
+                guard domain.contains(a) else {
+                    outside = outside ?? a
+                    return table[0]
+                }
+                return table[a - domain.lowerBound]
+            }, input: PythonObject(unsafe: input), output: output.map { PythonObject(unsafe: $0) })
+
+            if let outside = outside, let result = result {
+                decRef(result.assumingMemoryBound(to: PyObject.self))
+                raisePythonError("PyExc_ValueError", "\(outside) is outside the lambda's domain \(domain)")
+                return nil
+            }
+            return result
+        }
+        self.init(backend: PythonLambdaSupport(batch: pfn, name: "lmb\(PythonLambda.lambdaUniqueName())"))
+    }
+}
+
+internal enum PythonTabulation {
+
+    /// The results, boxed once. Must be called holding the GIL.
+    static func boxed<R: PythonLambdaResult>(_ results: [R]) -> [PythonObject] {
+        results.map { result in
+            guard let boxed = result.boxed() else {
+                clearPythonError()
+                fatalError("could not box the tabulated result \(result)")
+            }
+            defer { decRef(boxed.assumingMemoryBound(to: PyObject.self)) }
+            return PythonObject(unsafe: boxed)
+        }
+    }
+
+    /// A new reference to a tabulated result
+    @inline(__always)
+    static func result(_ boxed: PythonObject) -> UnsafeMutablePointer<PyObject>? {
+        let object = boxed.unsafePyObject
+        incRef(object)
+        return object
+    }
+}
@@ -0,0 +1,157 @@
+//
+//  PythonTime.swift
+//
+//
+//  Created by strictlyswift on 17-Oct-26.
+//
+
+import PythonKit
+import libpylamsupport
+
+/// A point in time, as nanoseconds since the Unix epoch: the value of a NumPy `datetime64[ns]` or a pandas
+/// `Timestamp`. `notATime` represents `NaT`. As in NumPy, arithmetic involving `NaT` gives `NaT`; so does
+/// arithmetic whose result is out of range, rather than trapping.
+///
+/// - Example:
+///
+///       let hourly = 𝝺{(t:PythonInstant) in t.rounded(down: .hours(1))}
+///       df["hour"] = df.time.apply(hourly)
+public struct PythonInstant: Hashable, Comparable {
+    public var nanoseconds: Int64
+
+    public init(nanoseconds: Int64) {
+        self.nanoseconds = nanoseconds
+    }
+
+    public static let notATime = PythonInstant(nanoseconds: .min)
+    public var isNotATime: Bool { nanoseconds == .min }
+
+    /// The start of the `interval`-long bucket (counting from the epoch) containing this instant; `NaT` if the
+    /// interval isn't positive (or is `NaT`), or the bucket starts out of range
+    public func rounded(down interval: PythonDuration) -> PythonInstant {
+        guard !isNotATime && interval.nanoseconds > 0 else { return .notATime }
+        let remainder = nanoseconds % interval.nanoseconds
+        return PythonInstant(nanoseconds: PythonTime.difference(nanoseconds, remainder < 0 ? remainder + interval.nanoseconds : remainder))
+    }
+
+    public static func < (lhs: PythonInstant, rhs: PythonInstant) -> Bool { lhs.nanoseconds < rhs.nanoseconds }
+    public static func + (lhs: PythonInstant, rhs: PythonDuration) -> PythonInstant { PythonInstant(nanoseconds: PythonTime.sum(lhs.nanoseconds, rhs.nanoseconds)) }
+    public static func - (lhs: PythonInstant, rhs: PythonDuration) -> PythonInstant { PythonInstant(nanoseconds: PythonTime.difference(lhs.nanoseconds, rhs.nanoseconds)) }
+    public static func - (lhs: PythonInstant, rhs: PythonInstant) -> PythonDuration { PythonDuration(nanoseconds: PythonTime.difference(lhs.nanoseconds, rhs.nanoseconds)) }
+}
+
+/// A length of time, in nanoseconds: the value of a NumPy `timedelta64[ns]` or a pandas `Timedelta`. `notATime`
+/// represents `NaT`, and as with `PythonInstant`, arithmetic involving it, or out of range, gives `NaT`.
+public struct PythonDuration: Hashable, Comparable {
+    public var nanoseconds: Int64
+
+    public init(nanoseconds: Int64) {
+        self.nanoseconds = nanoseconds
+    }
+
+    public static let notATime = PythonDuration(nanoseconds: .min)
+    public var isNotATime: Bool { nanoseconds == .min }
+
+    public static func seconds(_ n: Int64) -> PythonDuration { PythonDuration(nanoseconds: PythonTime.product(n, 1_000_000_000)) }
+    public static func minutes(_ n: Int64) -> PythonDuration { PythonDuration(nanoseconds: PythonTime.product(n, 60_000_000_000)) }
+    public static func hours(_ n: Int64) -> PythonDuration { PythonDuration(nanoseconds: PythonTime.product(n, 3_600_000_000_000)) }
+    public static func days(_ n: Int64) -> PythonDuration { PythonDuration(nanoseconds: PythonTime.product(n, 86_400_000_000_000)) }
+
+    public static func < (lhs: PythonDuration, rhs: PythonDuration) -> Bool { lhs.nanoseconds < rhs.nanoseconds }
+    public static func + (lhs: PythonDuration, rhs: PythonDuration) -> PythonDuration { PythonDuration(nanoseconds: PythonTime.sum(lhs.nanoseconds, rhs.nanoseconds)) }
+    public static func - (lhs: PythonDuration, rhs: PythonDuration) -> PythonDuration { PythonDuration(nanoseconds: PythonTime.difference(lhs.nanoseconds, rhs.nanoseconds)) }
+}
+
+extension PythonInstant: PythonLambdaArgument, PythonLambdaResult, PythonBufferElement {
+    /// Accepts `datetime64` scalars and pandas `Timestamp`s directly; anything else `pandas.Timestamp` accepts (eg a
+    /// `datetime.datetime`) is converted through it
+    public static func unboxed(from object: UnsafeMutableRawPointer) -> PythonInstant? {
+        PythonTime.nanoseconds(object, timedelta: false).map(PythonInstant.init(nanoseconds:))
+    }
+
+    /// A `numpy.datetime64` in nanoseconds
+    public func boxed() -> UnsafeMutableRawPointer? {
+        UnsafeMutableRawPointer(boxNanoseconds(nanoseconds, 0))
+    }
+
+    public static var numpyDType: String { "datetime64[ns]" }
+    public static var bufferDType: String { "int64" }
+    public static var bufferKind: PythonBufferKind { .signedInteger }
+}
+
+extension PythonDuration: PythonLambdaArgument, PythonLambdaResult, PythonBufferElement {
+    /// Accepts `timedelta64` scalars and pandas `Timedelta`s directly; anything else `pandas.Timedelta` accepts (eg a
+    /// `datetime.timedelta`) is converted through it
+    public static func unboxed(from object: UnsafeMutableRawPointer) -> PythonDuration? {
+        PythonTime.nanoseconds(object, timedelta: true).map(PythonDuration.init(nanoseconds:))
+    }
+
+    /// A `numpy.timedelta64` in nanoseconds
+    public func boxed() -> UnsafeMutableRawPointer? {
+        UnsafeMutableRawPointer(boxNanoseconds(nanoseconds, 1))
+    }
+
+    public static var numpyDType: String { "timedelta64[ns]" }
+    public static var bufferDType: String { "int64" }
+    public static var bufferKind: PythonBufferKind { .signedInteger }
+}
+
+internal enum PythonTime {
+    /// The nanoseconds value of `NaT`, for both instants and durations
+    static let notATime = Int64.min
+
+    /// `a + b`, or `NaT` if either is `NaT` or the sum is out of range
+    @inline(__always)
+    static func sum(_ a: Int64, _ b: Int64) -> Int64 {
+        guard a != notATime && b != notATime else { return notATime }
+        let (sum, overflow) = a.addingReportingOverflow(b)
+        return overflow ? notATime : sum
+    }
+
+    /// `a - b`, or `NaT` if either is `NaT` or the difference is out of range
+    @inline(__always)
+    static func difference(_ a: Int64, _ b: Int64) -> Int64 {
+        guard a != notATime && b != notATime else { return notATime }
+        let (difference, overflow) = a.subtractingReportingOverflow(b)
+        return overflow ? notATime : difference
+    }
+
+    /// `n * unit`, or `NaT` if `n` is `NaT` or the product is out of range
+    @inline(__always)
+    static func product(_ n: Int64, _ unit: Int64) -> Int64 {
+        guard n != notATime else { return notATime }
+        let (product, overflow) = n.multipliedReportingOverflow(by: unit)
+        return overflow ? notATime : product
+    }
+
+    /// pandas' Timestamp, Timedelta and NaTType, registered with the C unboxer the first time a value isn't a NumPy
+    /// scalar; kept here so the type pointers remain valid. Empty if pandas isn't installed.
+    static let pandasTypes: [PythonObject] = {
+        guard let pandas = try? Python.attemptImport("pandas") else { return [] }
+        let types = [pandas.Timestamp, pandas.Timedelta, Python.type(pandas.NaT)]
+        registerPandasTimeTypes(types[0].unsafePyObject, types[1].unsafePyObject, types[2].unsafePyObject)
+        return types
+    }()
+
+    /// The nanoseconds value of a time object; nil, with a Python exception set, if it can't be converted
+    static func nanoseconds(_ object: UnsafeMutableRawPointer, timedelta: Bool) -> Int64? {
+        let pyObject = object.assumingMemoryBound(to: PyObject.self)
+        var status: Int32 = 0
+        var value = unboxNanoseconds(pyObject, timedelta ? 1 : 0, &status)
+
+        if status < 0 && !pandasTypes.isEmpty {
+            // the pandas types are now registered, so Timestamps & Timedeltas are handled directly; otherwise convert
+            value = unboxNanoseconds(pyObject, timedelta ? 1 : 0, &status)
+            if status < 0, let converted = try? pandasTypes[timedelta ? 1 : 0].throwing.dynamicallyCall(withArguments: PythonObject(unsafe: object)) {
+                value = unboxNanoseconds(converted.unsafePyObject, timedelta ? 1 : 0, &status)
+            }
+        }
+
+        guard status != 0 else { return nil }
+        guard status > 0 else {
+            raisePythonError("PyExc_TypeError", "expected a \(timedelta ? "timedelta64 or Timedelta" : "datetime64 or Timestamp")")
+            return nil
+        }
+        return value
+    }
+}
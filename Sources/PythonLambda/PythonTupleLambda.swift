@@ -0,0 +1,169 @@
+//
+//  PythonTupleLambda.swift
+//
+//
+//  Created by strictlyswift on 17-Oct-26.
+//
+
+import PythonKit
+import libpylamsupport
+
+extension PythonLambda {
+
+    /// Creates a lambda returning a pair, as a Python tuple.
+    ///
+    /// The tuple is built directly from the boxed components, rather than via a `PythonObject` list.
+    ///
+    /// - Example:
+    ///
+    ///       let bounds = 𝝺{(x:Double) in (x.rounded(.down), x.rounded(.up))}
+    ///       let parsed = 𝝺{(s:String) in (s.count, s.uppercased())}
+    public convenience init<A: PythonLambdaArgument, R1: PythonLambdaResult, R2: PythonLambdaResult>(_ fn: @escaping (A) -> (R1, R2)) {
+        let pfn: PythonFastcallFunction = { args, nargs, kwnames in
+            guard let args = PythonTypedArguments.positional(args, nargs, kwnames, count: 1),
+                let a = A.unboxed(from: args[0]!) else { return nil }
+            let (r1, r2) = fn(a)
+            return PythonTypedArguments.tuple(r1.boxed(), r2.boxed())
+        }
+        self.init(backend: PythonLambdaSupport(fastcall: pfn, name: "lmb\(PythonLambda.lambdaUniqueName())"))
+    }
+
+    /// Creates a lambda returning a triple, as a Python tuple
+    public convenience init<A: PythonLambdaArgument, R1: PythonLambdaResult, R2: PythonLambdaResult, R3: PythonLambdaResult>(_ fn: @escaping (A) -> (R1, R2, R3)) {
+        let pfn: PythonFastcallFunction = { args, nargs, kwnames in
+            guard let args = PythonTypedArguments.positional(args, nargs, kwnames, count: 1),
+                let a = A.unboxed(from: args[0]!) else { return nil }
+            let (r1, r2, r3) = fn(a)
+            return PythonTypedArguments.tuple(r1.boxed(), r2.boxed(), r3.boxed())
+        }
+        self.init(backend: PythonLambdaSupport(fastcall: pfn, name: "lmb\(PythonLambda.lambdaUniqueName())"))
+    }
+
+    /// Creates a batch lambda returning a pair for each element, written into two separate output arrays.
+    ///
+    /// From Python, `f(xs)` returns a tuple of two new NumPy arrays, and `f(xs, (out1, out2))` fills existing ones.
+    ///
+    /// - Example:
+    ///
+    ///       let split = 𝝺(batch: {(x:Double) in (x.rounded(.towardZero), x.truncatingRemainder(dividingBy: 1))})
+    ///       let (whole, fraction) = split.pythonObject(df.x.values).tuple2
+    public convenience init<A: PythonBufferElement, R1: PythonBufferElement, R2: PythonBufferElement>( batch fn: @escaping (A) -> (R1, R2)) {
+        let name = "lmb\(PythonLambda.lambdaUniqueName())"
+
+        let pfn = { (input: PyObjectPointer, output: PyObjectPointer?) in
+            PythonBatch.map(fn, input: PythonObject(unsafe: input), output: output.map { PythonObject(unsafe: $0) })
+        }
+
+        self.init(backend: PythonLambdaSupport(batch: pfn, name: name))
+    }
+
+    /// Creates a batch lambda returning a triple for each element, written into three separate output arrays
+    public convenience init<A: PythonBufferElement, R1: PythonBufferElement, R2: PythonBufferElement, R3: PythonBufferElement>( batch fn: @escaping (A) -> (R1, R2, R3)) {
+        let name = "lmb\(PythonLambda.lambdaUniqueName())"
+
+        let pfn = { (input: PyObjectPointer, output: PyObjectPointer?) in
+            PythonBatch.map(fn, input: PythonObject(unsafe: input), output: output.map { PythonObject(unsafe: $0) })
+        }
+
+        self.init(backend: PythonLambdaSupport(batch: pfn, name: name))
+    }
+}
+
+extension PythonTypedArguments {
+
+    /// A new tuple of the boxed items, stealing their references; nil, with a Python exception set, if any is nil
+    @inline(__always)
+    static func tuple(_ first: UnsafeMutableRawPointer?, _ second: UnsafeMutableRawPointer?) -> UnsafeMutablePointer<PyObject>? {
+        withArgumentSlots(2) { items -> UnsafeMutablePointer<PyObject>? in
+            items[0] = first?.assumingMemoryBound(to: PyObject.self)
+            items[1] = second?.assumingMemoryBound(to: PyObject.self)
+            return packTuple(items, 2)
+        }
+    }
+
+    @inline(__always)
+    static func tuple(_ first: UnsafeMutableRawPointer?, _ second: UnsafeMutableRawPointer?, _ third: UnsafeMutableRawPointer?) -> UnsafeMutablePointer<PyObject>? {
+        withArgumentSlots(3) { items -> UnsafeMutablePointer<PyObject>? in
+            items[0] = first?.assumingMemoryBound(to: PyObject.self)
+            items[1] = second?.assumingMemoryBound(to: PyObject.self)
+            items[2] = third?.assumingMemoryBound(to: PyObject.self)
+            return packTuple(items, 3)
+        }
+    }
+}
+
+extension PythonBatch {
+
+    static func map<A: PythonBufferElement, R1: PythonBufferElement, R2: PythonBufferElement>(_ fn: (A) -> (R1, R2), input: PythonObject, output: PythonObject?) -> PyObjectPointer? {
+        guard let column = PythonBuffer.column(input, of: A.self) else { return nil }
+        let source = column.buffer
+        defer { source.release() }
+
+        guard let results = outputColumns(output, dtypes: [R1.numpyDType, R2.numpyDType], count: source.count),
+            let first = PythonBuffer.output(results[0], of: R1.self, count: source.count) else { return nil }
+        defer { first.release() }
+        guard let second = PythonBuffer.output(results[1], of: R2.self, count: source.count) else { return nil }
+        defer { second.release() }
+
+        withExtendedLifetime(column.owner) {
+            PythonGIL.withoutGIL {
+                for i in 0..<source.count {
+                    let (r1, r2) = fn(source.load(i, as: A.self))
+                    first.store(r1, at: i)
+                    second.store(r2, at: i)
+                }
+            }
+        }
+
+        return newTuple(of: results)
+    }
+
+    static func map<A: PythonBufferElement, R1: PythonBufferElement, R2: PythonBufferElement, R3: PythonBufferElement>(_ fn: (A) -> (R1, R2, R3), input: PythonObject, output: PythonObject?) -> PyObjectPointer? {
+        guard let column = PythonBuffer.column(input, of: A.self) else { return nil }
+        let source = column.buffer
+        defer { source.release() }
+
+        guard let results = outputColumns(output, dtypes: [R1.numpyDType, R2.numpyDType, R3.numpyDType], count: source.count),
+            let first = PythonBuffer.output(results[0], of: R1.self, count: source.count) else { return nil }
+        defer { first.release() }
+        guard let second = PythonBuffer.output(results[1], of: R2.self, count: source.count) else { return nil }
+        defer { second.release() }
+        guard let third = PythonBuffer.output(results[2], of: R3.self, count: source.count) else { return nil }
+        defer { third.release() }
+
+        withExtendedLifetime(column.owner) {
+            PythonGIL.withoutGIL {
+                for i in 0..<source.count {
+                    let (r1, r2, r3) = fn(source.load(i, as: A.self))
+                    first.store(r1, at: i)
+                    second.store(r2, at: i)
+                    third.store(r3, at: i)
+                }
+            }
+        }
+
+        return newTuple(of: results)
+    }
+
+    /// The arrays to write each component into: those passed as `output` (a tuple or list with one array per
+    /// component), or new ones. Nil, with a Python exception set, if `output` is the wrong shape.
+    static func outputColumns(_ output: PythonObject?, dtypes: [String], count: Int) -> [PythonObject]? {
+        guard let output = output else {
+            return dtypes.map { PythonNumpy.numpy.empty(count, dtype: $0) }
+        }
+        guard Bool(Python.isinstance(output, PythonObject(tupleOf: Python.tuple, Python.list)))!,
+            Int(Python.len(output))! == dtypes.count else {
+            raisePythonError("PyExc_ValueError", "output must be a tuple of \(dtypes.count) arrays")
+            return nil
+        }
+        return (0..<dtypes.count).map { output[$0] }
+    }
+
+    /// A new reference to a tuple of `columns`
+    static func newTuple(of columns: [PythonObject]) -> PyObjectPointer? {
+        let tuple = PythonObject(tupleContentsOf: columns)
+        return withExtendedLifetime(tuple) {
+            UnsafeMutableRawPointer(wrapObject(tuple.unsafePyObject))
+        }
+    }
+}
@@ -0,0 +1,299 @@
+//
+//  PythonTypedLambda.swift
+//
+//
+//  Created by strictlyswift on 17-Oct-26.
+//
+
+import PythonKit
+import libpylamsupport
+
+/// Swift types which a lambda can take as an argument, converted directly from the Python object passed in.
+public protocol PythonLambdaArgument {
+    /// Converts a borrowed `PyObject`; nil, with a Python exception set, if it can't be converted
+    static func unboxed(from object: UnsafeMutableRawPointer) -> Self?
+    /// Opens a column (eg a pandas Series) for converting its elements to Swift a range of rows at a time, reading
+    /// its memory directly where the type is also a `PythonBufferElement`. `body` is called with the number of rows
+    /// and a function converting a range of them, which must be called holding the GIL; it's a fatal error if an
+    /// element can't be converted. Must be called holding the GIL.
+    static func withRows<R>(of column: PythonObject, _ body: (Int, (Range<Int>) -> [Self]) -> R) -> R
+}
+
+extension PythonLambdaArgument {
+    /// Converts every element of a column (eg a pandas Series) into a Swift array. See `withRows(of:_:)`.
+    public static func unboxedColumn(_ column: PythonObject) -> [Self] {
+        withRows(of: column) { count, rows in rows(0..<count) }
+    }
+
+    public static func withRows<R>(of column: PythonObject, _ body: (Int, (Range<Int>) -> [Self]) -> R) -> R {
+        withListRows(of: Python.list(column), body)
+    }
+
+    /// Converts every element of a Python list, unboxing each one, as `unboxedColumn` would but without copying
+    /// the list first. Must be called holding the GIL.
+    static func unboxedList(_ list: PythonObject) -> [Self] {
+        withListRows(of: list) { count, rows in rows(0..<count) }
+    }
+
+    private static func withListRows<R>(of list: PythonObject, _ body: (Int, (Range<Int>) -> [Self]) -> R) -> R {
+        withExtendedLifetime(list) {
+            var count: CLong = 0
+            let items = listItems(list.unsafePyObject, &count)!
+            return body(Int(count)) { rows in
+                rows.map { i in
+                    guard let value = unboxed(from: items[i]!) else {
+                        clearPythonError()
+                        fatalError("element \(i) of the column can't be converted to \(Self.self)")
+                    }
+                    return value
+                }
+            }
+        }
+    }
+}
+
+extension PythonLambdaArgument where Self: PythonBufferElement {
+    public static func withRows<R>(of column: PythonObject, _ body: (Int, (Range<Int>) -> [Self]) -> R) -> R {
+        let opened = PythonBuffer.requireColumn(column, of: Self.self)
+        defer { opened.buffer.release() }
+        return withExtendedLifetime(opened.owner) {
+            body(opened.buffer.count) { rows in rows.map { opened.buffer.load($0, as: Self.self) } }
+        }
+    }
+}
+
+extension PythonLambdaResult {
+    /// The value as a `PythonObject`. Must be called holding the GIL.
+    var boxedPythonObject: PythonObject {
+        guard let boxed = boxed() else {
+            clearPythonError()
+            fatalError("\(self) can't be converted to Python")
+        }
+        defer { decRef(boxed.assumingMemoryBound(to: PyObject.self)) }
+        return PythonObject(unsafe: boxed)
+    }
+}
+
+/// Swift types which a lambda can return, converted directly to a new Python object.
+public protocol PythonLambdaResult {
+    /// A new `PyObject` reference; nil, with a Python exception set, on failure
+    func boxed() -> UnsafeMutableRawPointer?
+}
+
+extension Int: PythonLambdaArgument, PythonLambdaResult {
+    public static func unboxed(from object: UnsafeMutableRawPointer) -> Int? {
+        var ok: Int32 = 0
+        let value = unboxLongInt(object.assumingMemoryBound(to: PyObject.self), &ok)
+        return ok != 0 ? Int(value) : nil
+    }
+
+    public func boxed() -> UnsafeMutableRawPointer? {
+        UnsafeMutableRawPointer(boxLongInt(CLong(self)))
+    }
+}
+
+extension Double: PythonLambdaArgument, PythonLambdaResult {
+    public static func unboxed(from object: UnsafeMutableRawPointer) -> Double? {
+        var ok: Int32 = 0
+        let value = unboxDouble(object.assumingMemoryBound(to: PyObject.self), &ok)
+        return ok != 0 ? value : nil
+    }
+
+    public func boxed() -> UnsafeMutableRawPointer? {
+        UnsafeMutableRawPointer(boxDouble(self))
+    }
+}
+
+extension Float: PythonLambdaArgument, PythonLambdaResult {
+    public static func unboxed(from object: UnsafeMutableRawPointer) -> Float? {
+        Double.unboxed(from: object).map { Float($0) }
+    }
+
+    public func boxed() -> UnsafeMutableRawPointer? {
+        Double(self).boxed()
+    }
+}
+
+extension Int64: PythonLambdaArgument, PythonLambdaResult {
+    public static func unboxed(from object: UnsafeMutableRawPointer) -> Int64? { narrowed(from: object) }
+    public func boxed() -> UnsafeMutableRawPointer? { Int(self).boxed() }
+}
+
+extension Int32: PythonLambdaArgument, PythonLambdaResult {
+    public static func unboxed(from object: UnsafeMutableRawPointer) -> Int32? { narrowed(from: object) }
+    public func boxed() -> UnsafeMutableRawPointer? { Int(self).boxed() }
+}
+
+extension Int16: PythonLambdaArgument, PythonLambdaResult {
+    public static func unboxed(from object: UnsafeMutableRawPointer) -> Int16? { narrowed(from: object) }
+    public func boxed() -> UnsafeMutableRawPointer? { Int(self).boxed() }
+}
+
+extension UInt8: PythonLambdaArgument, PythonLambdaResult {
+    public static func unboxed(from object: UnsafeMutableRawPointer) -> UInt8? { narrowed(from: object) }
+    public func boxed() -> UnsafeMutableRawPointer? { Int(self).boxed() }
+}
+
+extension FixedWidthInteger {
+    /// Unboxes a Python int which must fit in this type, raising `OverflowError` if it doesn't
+    static func narrowed(from object: UnsafeMutableRawPointer) -> Self? {
+        guard let value = Int.unboxed(from: object) else { return nil }
+        guard let narrowed = Self(exactly: value) else {
+            raisePythonError("PyExc_OverflowError", "\(value) is out of range for \(Self.self)")
+            return nil
+        }
+        return narrowed
+    }
+}
+
+extension Bool: PythonLambdaArgument, PythonLambdaResult {
+    /// Uses Python's truth value of the object, as `bool(x)` would
+    public static func unboxed(from object: UnsafeMutableRawPointer) -> Bool? {
+        var ok: Int32 = 0
+        let value = unboxBool(object.assumingMemoryBound(to: PyObject.self), &ok)
+        return ok != 0 ? value != 0 : nil
+    }
+
+    public func boxed() -> UnsafeMutableRawPointer? {
+        UnsafeMutableRawPointer(wrapBool(self ? 1 : 0))
+    }
+}
+
+extension String: PythonLambdaArgument, PythonLambdaResult {
+    public static func unboxed(from object: UnsafeMutableRawPointer) -> String? {
+        var length: CLong = 0
+        guard let utf8 = unboxString(object.assumingMemoryBound(to: PyObject.self), &length) else { return nil }
+        return String(decoding: UnsafeRawBufferPointer(start: utf8, count: Int(length)), as: UTF8.self)
+    }
+
+    public func boxed() -> UnsafeMutableRawPointer? {
+        var string = self
+        return string.withUTF8 { utf8 in
+            utf8.withMemoryRebound(to: CChar.self) {
+                UnsafeMutableRawPointer(boxString($0.baseAddress, CLong($0.count)))
+            }
+        }
+    }
+}
+
+extension PythonLambda {
+
+    /// Creates a lambda from a Swift function of one typed argument, for the types without a dedicated shape, eg
+    /// `Float`, `Int32`, `Int16`, `UInt8` or `Int64`.
+    ///
+    /// - Example:
+    ///
+    ///       let celsius = 𝝺{(f:Float) in (f - 32) * 5 / 9}
+    ///
+    /// Integer arguments which don't fit the parameter type raise `OverflowError`. For arrays of these types, see
+    /// `init(batch:)`, which works on the arrays' native element width.
+    public convenience init<A: PythonLambdaArgument, R: PythonLambdaResult>(_ fn: @escaping (A) -> R) {
+        let pfn: PythonFastcallFunction = { args, nargs, kwnames in
+            guard let args = PythonTypedArguments.positional(args, nargs, kwnames, count: 1),
+                let a = A.unboxed(from: args[0]!) else { return nil }
+            return PythonTypedArguments.result(fn(a))
+        }
+        self.init(backend: PythonLambdaSupport(fastcall: pfn, name: "lmb\(PythonLambda.lambdaUniqueName())"))
+    }
+
+    /// Creates a lambda from a Swift function of 2 typed arguments.
+    ///
+    /// Shapes of two to six arguments are supported, over any `PythonLambdaArgument` types (eg `Int`, `Double`, `Bool`
+    /// or `String`), returning any `PythonLambdaResult`. Each argument is converted straight from the `PyObject`
+    /// passed in, and the result straight back, without intermediate `PythonObject`s.
+    ///
+    /// - Example:
+    ///
+    ///       let adder = 𝝺{(x:Double, y:Double) in x+y}
+    ///       let total = Python.import("functools").reduce(adder, xs, 0.0)
+    ///       let combined = s1.combine(s2, 𝝺{(a:Int, b:Int) in max(a,b)})
+    ///
+    /// - Note: arguments must be passed positionally.
+    public convenience init<A: PythonLambdaArgument, B: PythonLambdaArgument, R: PythonLambdaResult>(_ fn: @escaping (A, B) -> R) {
+        let pfn: PythonFastcallFunction = { args, nargs, kwnames in
+            guard let args = PythonTypedArguments.positional(args, nargs, kwnames, count: 2),
+                let a = A.unboxed(from: args[0]!),
+                let b = B.unboxed(from: args[1]!) else { return nil }
+            return PythonTypedArguments.result(fn(a, b))
+        }
+        self.init(backend: PythonLambdaSupport(fastcall: pfn, name: "lmb\(PythonLambda.lambdaUniqueName())"))
+    }
+
+    /// Creates a lambda from a Swift function of 3 typed arguments
+    public convenience init<A: PythonLambdaArgument, B: PythonLambdaArgument, C: PythonLambdaArgument, R: PythonLambdaResult>(_ fn: @escaping (A, B, C) -> R) {
+        let pfn: PythonFastcallFunction = { args, nargs, kwnames in
+            guard let args = PythonTypedArguments.positional(args, nargs, kwnames, count: 3),
+                let a = A.unboxed(from: args[0]!),
+                let b = B.unboxed(from: args[1]!),
+                let c = C.unboxed(from: args[2]!) else { return nil }
+            return PythonTypedArguments.result(fn(a, b, c))
+        }
+        self.init(backend: PythonLambdaSupport(fastcall: pfn, name: "lmb\(PythonLambda.lambdaUniqueName())"))
+    }
+
+    /// Creates a lambda from a Swift function of 4 typed arguments
+    public convenience init<A: PythonLambdaArgument, B: PythonLambdaArgument, C: PythonLambdaArgument, D: PythonLambdaArgument, R: PythonLambdaResult>(_ fn: @escaping (A, B, C, D) -> R) {
+        let pfn: PythonFastcallFunction = { args, nargs, kwnames in
+            guard let args = PythonTypedArguments.positional(args, nargs, kwnames, count: 4),
+                let a = A.unboxed(from: args[0]!),
+                let b = B.unboxed(from: args[1]!),
+                let c = C.unboxed(from: args[2]!),
+                let d = D.unboxed(from: args[3]!) else { return nil }
+            return PythonTypedArguments.result(fn(a, b, c, d))
+        }
+        self.init(backend: PythonLambdaSupport(fastcall: pfn, name: "lmb\(PythonLambda.lambdaUniqueName())"))
+    }
+
+    /// Creates a lambda from a Swift function of 5 typed arguments
+    public convenience init<A: PythonLambdaArgument, B: PythonLambdaArgument, C: PythonLambdaArgument, D: PythonLambdaArgument, E: PythonLambdaArgument, R: PythonLambdaResult>(_ fn: @escaping (A, B, C, D, E) -> R) {
+        let pfn: PythonFastcallFunction = { args, nargs, kwnames in
+            guard let args = PythonTypedArguments.positional(args, nargs, kwnames, count: 5),
+                let a = A.unboxed(from: args[0]!),
+                let b = B.unboxed(from: args[1]!),
+                let c = C.unboxed(from: args[2]!),
+                let d = D.unboxed(from: args[3]!),
+                let e = E.unboxed(from: args[4]!) else { return nil }
+            return PythonTypedArguments.result(fn(a, b, c, d, e))
+        }
+        self.init(backend: PythonLambdaSupport(fastcall: pfn, name: "lmb\(PythonLambda.lambdaUniqueName())"))
+    }
+
+    /// Creates a lambda from a Swift function of 6 typed arguments
+    public convenience init<A: PythonLambdaArgument, B: PythonLambdaArgument, C: PythonLambdaArgument, D: PythonLambdaArgument, E: PythonLambdaArgument, F: PythonLambdaArgument, R: PythonLambdaResult>(_ fn: @escaping (A, B, C, D, E, F) -> R) {
+        let pfn: PythonFastcallFunction = { args, nargs, kwnames in
+            guard let args = PythonTypedArguments.positional(args, nargs, kwnames, count: 6),
+                let a = A.unboxed(from: args[0]!),
+                let b = B.unboxed(from: args[1]!),
+                let c = C.unboxed(from: args[2]!),
+                let d = D.unboxed(from: args[3]!),
+                let e = E.unboxed(from: args[4]!),
+                let f = F.unboxed(from: args[5]!) else { return nil }
+            return PythonTypedArguments.result(fn(a, b, c, d, e, f))
+        }
+        self.init(backend: PythonLambdaSupport(fastcall: pfn, name: "lmb\(PythonLambda.lambdaUniqueName())"))
+    }
+}
+
+/// Helpers for the typed N-argument trampolines
+internal enum PythonTypedArguments {
+
+    /// The arguments, if exactly `count` were passed positionally; otherwise nil, with a Python exception set
+    @inline(__always)
+    static func positional(_ args: UnsafePointer<UnsafeMutablePointer<PyObject>?>?,
+                           _ nargs: Int,
+                           _ kwnames: UnsafeMutablePointer<PyObject>?,
+                           count: Int) -> UnsafePointer<UnsafeMutablePointer<PyObject>?>? {
+        guard nargs == count, kwnames == nil, let args = args else {
+            raisePythonError("PyExc_TypeError", kwnames == nil
+                ? "lambda takes exactly \(count) arguments (\(nargs) given)"
+                : "lambda takes no keyword arguments")
+            return nil
+        }
+        return args
+    }
+
+    @inline(__always)
+    static func result<R: PythonLambdaResult>(_ value: R) -> UnsafeMutablePointer<PyObject>? {
+        value.boxed()?.assumingMemoryBound(to: PyObject.self)
+    }
+}
@@ -8,6 +8,9 @@
 
 #include "include/LambdaBuilder.h"
 #include <dlfcn.h>
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
 
 static void* _pythonLibraryHandle;
 int (*pyarg_parsetuple)(PyObject *args, const char *format, ...);
@@ -16,6 +19,43 @@ const char* (*pyunicode_asutf8)(PyObject*);
 PyObject* (*pyunicode_fromstring)(const char*);
 PyObject* (*py_createPyCFunction)(PyMethodDef*, PyObject*, PyObject*);
 PyObject* (*py_boolfromlong)(long v);
+int (*pygilstate_ensure)(void);
+void (*pygilstate_release)(int);
+void (*pyerr_setstring)(PyObject*, const char*);
+void* (*pyeval_savethread)(void);
+void (*pyeval_restorethread)(void*);
+void (*pyos_beforefork)(void);
+void (*pyos_afterfork_parent)(void);
+void (*pyos_afterfork_child)(void);
+void (*pyerr_clear)(void);
+int (*pyobject_getbuffer)(PyObject*, Py_buffer*, int);
+void (*pybuffer_release)(Py_buffer*);
+void (*py_incref)(PyObject*);
+void (*py_decref)(PyObject*);
+PyObject* (*pyunicode_internfromstring)(const char*);
+int (*pyunicode_compare)(PyObject*, PyObject*);
+PyObject* (*pyerr_occurred)(void);
+long (*pylong_aslong)(PyObject*);
+double (*pyfloat_asdouble)(PyObject*);
+int (*pyobject_istrue)(PyObject*);
+const char* (*pyunicode_asutf8andsize)(PyObject*, Py_ssize_t*);
+PyObject* (*pylong_fromlong)(long);
+PyObject* (*pyfloat_fromdouble)(double);
+PyObject* (*pyunicode_fromstringandsize)(const char*, Py_ssize_t);
+static PyTypeObject* pyfloat_type;
+static PyTypeObject* pylong_type;
+PyObject* (*pytuple_new)(Py_ssize_t);
+PyObject* (*pyimport_importmodule)(const char*);
+PyObject* (*pyobject_getattrstring)(PyObject*, const char*);
+long long (*pylong_aslonglong)(PyObject*);
+PyObject* (*pybytes_fromstringandsize)(const char*, Py_ssize_t);
+static PyObject* py_none;
+static PyTypeObject* pybool_type;
+PyObject* (*pylist_new)(Py_ssize_t);
+PyObject* (*pytype_fromspec)(PyType_Spec*);
+void (*pyerr_setobject)(PyObject*, PyObject*);
+PyObject* (*pyobject_getiter)(PyObject*);
+PyObject* (*pysequence_fast)(PyObject*, const char*);
 
 int initialisePythonLibrary(void* libraryHandle) {
     _pythonLibraryHandle = libraryHandle;
@@ -26,6 +66,43 @@ int initialisePythonLibrary(void* libraryHandle) {
     pyunicode_fromstring = GetProcAddress((HINSTANCE__)libraryHandle, "PyUnicode_FromString");
     py_boolfromlong = GetProcAddress((HINSTANCE__)libraryHandle, "PyBool_FromLong");
     py_createPyCFunction = GetProcAddress((HINSTANCE__)libraryHandle, "PyCFunction_NewEx");
+    pygilstate_ensure = GetProcAddress((HINSTANCE__)libraryHandle, "PyGILState_Ensure");
+    pygilstate_release = GetProcAddress((HINSTANCE__)libraryHandle, "PyGILState_Release");
+    pyerr_setstring = GetProcAddress((HINSTANCE__)libraryHandle, "PyErr_SetString");
+    pyeval_savethread = GetProcAddress((HINSTANCE__)libraryHandle, "PyEval_SaveThread");
+    pyeval_restorethread = GetProcAddress((HINSTANCE__)libraryHandle, "PyEval_RestoreThread");
+    pyos_beforefork = GetProcAddress((HINSTANCE__)libraryHandle, "PyOS_BeforeFork");
+    pyos_afterfork_parent = GetProcAddress((HINSTANCE__)libraryHandle, "PyOS_AfterFork_Parent");
+    pyos_afterfork_child = GetProcAddress((HINSTANCE__)libraryHandle, "PyOS_AfterFork_Child");
+    pyerr_clear = GetProcAddress((HINSTANCE__)libraryHandle, "PyErr_Clear");
+    pyobject_getbuffer = GetProcAddress((HINSTANCE__)libraryHandle, "PyObject_GetBuffer");
+    pybuffer_release = GetProcAddress((HINSTANCE__)libraryHandle, "PyBuffer_Release");
+    py_incref = GetProcAddress((HINSTANCE__)libraryHandle, "Py_IncRef");
+    py_decref = GetProcAddress((HINSTANCE__)libraryHandle, "Py_DecRef");
+    pyunicode_internfromstring = GetProcAddress((HINSTANCE__)libraryHandle, "PyUnicode_InternFromString");
+    pyunicode_compare = GetProcAddress((HINSTANCE__)libraryHandle, "PyUnicode_Compare");
+    pyerr_occurred = GetProcAddress((HINSTANCE__)libraryHandle, "PyErr_Occurred");
+    pylong_aslong = GetProcAddress((HINSTANCE__)libraryHandle, "PyLong_AsLong");
+    pyfloat_asdouble = GetProcAddress((HINSTANCE__)libraryHandle, "PyFloat_AsDouble");
+    pyobject_istrue = GetProcAddress((HINSTANCE__)libraryHandle, "PyObject_IsTrue");
+    pyunicode_asutf8andsize = GetProcAddress((HINSTANCE__)libraryHandle, "PyUnicode_AsUTF8AndSize");
+    pylong_fromlong = GetProcAddress((HINSTANCE__)libraryHandle, "PyLong_FromLong");
+    pyfloat_fromdouble = GetProcAddress((HINSTANCE__)libraryHandle, "PyFloat_FromDouble");
+    pyunicode_fromstringandsize = GetProcAddress((HINSTANCE__)libraryHandle, "PyUnicode_FromStringAndSize");
+    pyfloat_type = GetProcAddress((HINSTANCE__)libraryHandle, "PyFloat_Type");
+    pylong_type = GetProcAddress((HINSTANCE__)libraryHandle, "PyLong_Type");
+    pytuple_new = GetProcAddress((HINSTANCE__)libraryHandle, "PyTuple_New");
+    pyimport_importmodule = GetProcAddress((HINSTANCE__)libraryHandle, "PyImport_ImportModule");
+    pyobject_getattrstring = GetProcAddress((HINSTANCE__)libraryHandle, "PyObject_GetAttrString");
+    pylong_aslonglong = GetProcAddress((HINSTANCE__)libraryHandle, "PyLong_AsLongLong");
+    pybytes_fromstringandsize = GetProcAddress((HINSTANCE__)libraryHandle, "PyBytes_FromStringAndSize");
+    py_none = GetProcAddress((HINSTANCE__)libraryHandle, "_Py_NoneStruct");
+    pybool_type = GetProcAddress((HINSTANCE__)libraryHandle, "PyBool_Type");
+    pylist_new = GetProcAddress((HINSTANCE__)libraryHandle, "PyList_New");
+    pytype_fromspec = GetProcAddress((HINSTANCE__)libraryHandle, "PyType_FromSpec");
+    pyerr_setobject = GetProcAddress((HINSTANCE__)libraryHandle, "PyErr_SetObject");
+    pyobject_getiter = GetProcAddress((HINSTANCE__)libraryHandle, "PyObject_GetIter");
+    pysequence_fast = GetProcAddress((HINSTANCE__)libraryHandle, "PySequence_Fast");
 #else
     pyarg_parsetuple = dlsym(_pythonLibraryHandle, "PyArg_ParseTuple");
     py_buildvalue = dlsym(_pythonLibraryHandle, "Py_BuildValue");
@@ -33,7 +110,54 @@ int initialisePythonLibrary(void* libraryHandle) {
     pyunicode_fromstring = dlsym(_pythonLibraryHandle, "PyUnicode_FromString");
     py_boolfromlong = dlsym(_pythonLibraryHandle, "PyBool_FromLong");
     py_createPyCFunction = dlsym(_pythonLibraryHandle, "PyCFunction_NewEx");
+    pygilstate_ensure = dlsym(_pythonLibraryHandle, "PyGILState_Ensure");
+    pygilstate_release = dlsym(_pythonLibraryHandle, "PyGILState_Release");
+    pyerr_setstring = dlsym(_pythonLibraryHandle, "PyErr_SetString");
+    pyeval_savethread = dlsym(_pythonLibraryHandle, "PyEval_SaveThread");
+    pyeval_restorethread = dlsym(_pythonLibraryHandle, "PyEval_RestoreThread");
+    pyos_beforefork = dlsym(_pythonLibraryHandle, "PyOS_BeforeFork");
+    pyos_afterfork_parent = dlsym(_pythonLibraryHandle, "PyOS_AfterFork_Parent");
+    pyos_afterfork_child = dlsym(_pythonLibraryHandle, "PyOS_AfterFork_Child");
+    pyerr_clear = dlsym(_pythonLibraryHandle, "PyErr_Clear");
+    pyobject_getbuffer = dlsym(_pythonLibraryHandle, "PyObject_GetBuffer");
+    pybuffer_release = dlsym(_pythonLibraryHandle, "PyBuffer_Release");
+    py_incref = dlsym(_pythonLibraryHandle, "Py_IncRef");
+    py_decref = dlsym(_pythonLibraryHandle, "Py_DecRef");
+    pyunicode_internfromstring = dlsym(_pythonLibraryHandle, "PyUnicode_InternFromString");
+    pyunicode_compare = dlsym(_pythonLibraryHandle, "PyUnicode_Compare");
+    pyerr_occurred = dlsym(_pythonLibraryHandle, "PyErr_Occurred");
+    pylong_aslong = dlsym(_pythonLibraryHandle, "PyLong_AsLong");
+    pyfloat_asdouble = dlsym(_pythonLibraryHandle, "PyFloat_AsDouble");
+    pyobject_istrue = dlsym(_pythonLibraryHandle, "PyObject_IsTrue");
+    pyunicode_asutf8andsize = dlsym(_pythonLibraryHandle, "PyUnicode_AsUTF8AndSize");
+    pylong_fromlong = dlsym(_pythonLibraryHandle, "PyLong_FromLong");
+    pyfloat_fromdouble = dlsym(_pythonLibraryHandle, "PyFloat_FromDouble");
+    pyunicode_fromstringandsize = dlsym(_pythonLibraryHandle, "PyUnicode_FromStringAndSize");
+    pyfloat_type = dlsym(_pythonLibraryHandle, "PyFloat_Type");
+    pylong_type = dlsym(_pythonLibraryHandle, "PyLong_Type");
+    pytuple_new = dlsym(_pythonLibraryHandle, "PyTuple_New");
+    pyimport_importmodule = dlsym(_pythonLibraryHandle, "PyImport_ImportModule");
+    pyobject_getattrstring = dlsym(_pythonLibraryHandle, "PyObject_GetAttrString");
+    pylong_aslonglong = dlsym(_pythonLibraryHandle, "PyLong_AsLongLong");
+    pybytes_fromstringandsize = dlsym(_pythonLibraryHandle, "PyBytes_FromStringAndSize");
+    py_none = dlsym(_pythonLibraryHandle, "_Py_NoneStruct");
+    pybool_type = dlsym(_pythonLibraryHandle, "PyBool_Type");
+    pylist_new = dlsym(_pythonLibraryHandle, "PyList_New");
+    pytype_fromspec = dlsym(_pythonLibraryHandle, "PyType_FromSpec");
+    pyerr_setobject = dlsym(_pythonLibraryHandle, "PyErr_SetObject");
+    pyobject_getiter = dlsym(_pythonLibraryHandle, "PyObject_GetIter");
+    pysequence_fast = dlsym(_pythonLibraryHandle, "PySequence_Fast");
+#endif
+    return 1;
+}
+
+static PyObject* pythonException(const char* name) {
+#ifdef _WIN32
+    PyObject** exception = GetProcAddress((HINSTANCE__)_pythonLibraryHandle, name);
+#else
+    PyObject** exception = dlsym(_pythonLibraryHandle, name);
 #endif
+    return exception == NULL ? NULL : *exception;
 }
 
 char* parseArgsToString(PyObject *args, long int *error) {
@@ -45,6 +169,12 @@ char* parseArgsToString(PyObject *args, long int *error) {
 }
 
 double parseArgsToDouble(PyObject *args, long int *error) {
+    if (PyTuple_GET_SIZE(args) == 1) {
+        int ok;
+        double unboxed = unboxDouble(PyTuple_GET_ITEM(args, 0), &ok);
+        *error = ok;
+        return unboxed;
+    }
     double value;
     int result = (*pyarg_parsetuple)(args, "d", &value);
     
@@ -54,6 +184,12 @@ double parseArgsToDouble(PyObject *args, long int *error) {
 
 
 long int parseArgsToLongInt(PyObject *args, long int *error) {
+    if (PyTuple_GET_SIZE(args) == 1) {
+        int ok;
+        long int unboxed = unboxLongInt(PyTuple_GET_ITEM(args, 0), &ok);
+        *error = ok;
+        return unboxed;
+    }
     long int value;
     int result = (*pyarg_parsetuple)(args, "l", &value);
     
@@ -91,6 +227,16 @@ PyObject* parseArgsToObjectTriple(PyObject *args, PyObject **objectB, PyObject *
     return valueA;
 }
 
+PyObject* parseArgsToObjectAndOptionalObject(PyObject *args, PyObject **objectB, long int *error) {
+    PyObject* valueA;
+    PyObject* valueB = NULL;
+    int result = (*pyarg_parsetuple)(args, "O|O", &valueA, &valueB);
+    
+    *error = result;
+    *objectB = valueB;
+    return valueA;
+}
+
 PyObject* wrapLongInt(long int value) {
     PyObject* pyValue = (*py_buildvalue)("l",value);
     return pyValue;
@@ -115,6 +261,473 @@ PyObject* wrapBool(long int value) {
     PyObject* pyValue = (*py_boolfromlong)(value);
     return pyValue;
 }
+// NumPy scalar types, found the first time a NumPy scalar is unboxed. Their values are stored straight after the
+// object header (eg `npy_double obval` in PyDoubleScalarObject), so can be read without calling into NumPy.
+static int numpyScalarTypesLoaded = 0;
+static PyTypeObject* np_float64;
+static PyTypeObject* np_float32;
+static PyTypeObject* np_int64;
+static PyTypeObject* np_int32;
+static PyTypeObject* np_int16;
+static PyTypeObject* np_uint8;
+static PyTypeObject* np_bool;
+
+#define NUMPY_SCALAR_VALUE(object, type) (*(type*)((char*)(object) + sizeof(PyObject)))
+
+static PyTypeObject* numpyScalarType(PyObject* numpy, const char* name) {
+    PyObject* type = (*pyobject_getattrstring)(numpy, name);
+    if (type == NULL) {
+        (*pyerr_clear)();
+    }
+    return (PyTypeObject*)type; // the reference is kept, so the pointer stays valid
+}
+
+static PyTypeObject* np_datetime64;
+static PyTypeObject* np_timedelta64;
+
+// Returns 1 if the types have just been loaded
+static int ensureNumpyScalarTypes(void) {
+    if (numpyScalarTypesLoaded) {
+        return 0;
+    }
+    numpyScalarTypesLoaded = 1;
+
+    PyObject* numpy = (*pyimport_importmodule)("numpy");
+    if (numpy == NULL) {
+        (*pyerr_clear)();
+        return 0;
+    }
+    np_float64 = numpyScalarType(numpy, "float64");
+    np_float32 = numpyScalarType(numpy, "float32");
+    np_int64 = numpyScalarType(numpy, "int64");
+    np_int32 = numpyScalarType(numpy, "int32");
+    np_int16 = numpyScalarType(numpy, "int16");
+    np_uint8 = numpyScalarType(numpy, "uint8");
+    np_bool = numpyScalarType(numpy, "bool_");
+    np_datetime64 = numpyScalarType(numpy, "datetime64");
+    np_timedelta64 = numpyScalarType(numpy, "timedelta64");
+    (*py_decref)(numpy);
+    return 1;
+}
+
+// Returns 1 if the types have just been loaded, ie it's worth trying the fast paths again
+static int loadNumpyScalarTypes(PyTypeObject* seen) {
+    if (numpyScalarTypesLoaded || strncmp(seen->tp_name, "numpy.", 6) != 0) {
+        return 0;
+    }
+    return ensureNumpyScalarTypes();
+}
+
+long int unboxLongInt(PyObject* object, int* ok) {
+    PyTypeObject* type = Py_TYPE(object);
+    if (type != pylong_type) {
+        *ok = 1;
+        if (type == np_int64) return (long int)NUMPY_SCALAR_VALUE(object, int64_t);
+        if (type == np_int32) return NUMPY_SCALAR_VALUE(object, int32_t);
+        if (type == np_int16) return NUMPY_SCALAR_VALUE(object, int16_t);
+        if (type == np_uint8) return NUMPY_SCALAR_VALUE(object, uint8_t);
+        if (type == np_bool) return NUMPY_SCALAR_VALUE(object, unsigned char) != 0;
+        if (loadNumpyScalarTypes(type)) return unboxLongInt(object, ok);
+    }
+    long value = (*pylong_aslong)(object);
+    *ok = !(value == -1 && (*pyerr_occurred)() != NULL);
+    return value;
+}
+
+double unboxDouble(PyObject* object, int* ok) {
+    PyTypeObject* type = Py_TYPE(object);
+    *ok = 1;
+    if (type == pyfloat_type) return PyFloat_AS_DOUBLE(object);
+    if (type == np_float64) return NUMPY_SCALAR_VALUE(object, double);
+    if (type == np_float32) return NUMPY_SCALAR_VALUE(object, float);
+    if (type == np_int64) return (double)NUMPY_SCALAR_VALUE(object, int64_t);
+    if (type == np_int32) return NUMPY_SCALAR_VALUE(object, int32_t);
+    if (type != pylong_type && loadNumpyScalarTypes(type)) return unboxDouble(object, ok);
+
+    double value = (*pyfloat_asdouble)(object);
+    *ok = !(value == -1.0 && (*pyerr_occurred)() != NULL);
+    return value;
+}
+
+long int unboxBool(PyObject* object, int* ok) {
+    PyTypeObject* type = Py_TYPE(object);
+    if (type == np_bool) {
+        *ok = 1;
+        return NUMPY_SCALAR_VALUE(object, unsigned char) != 0;
+    }
+    if (loadNumpyScalarTypes(type)) return unboxBool(object, ok);
+    int value = (*pyobject_istrue)(object);
+    *ok = value >= 0;
+    return value > 0;
+}
+
+const char* unboxString(PyObject* object, long int* length) {
+    Py_ssize_t size = 0;
+    const char* value = (*pyunicode_asutf8andsize)(object, &size);
+    *length = size;
+    return value;
+}
+
+int classifyNumber(PyObject* object, long int* intValue, double* doubleValue) {
+    PyTypeObject* type = Py_TYPE(object);
+    if (type == pyfloat_type) {
+        *doubleValue = PyFloat_AS_DOUBLE(object);
+        return NUMBER_KIND_DOUBLE;
+    }
+    if (type == pylong_type || type == pybool_type) {
+        *intValue = (*pylong_aslong)(object);
+        return (*intValue == -1 && (*pyerr_occurred)() != NULL) ? NUMBER_KIND_ERROR : NUMBER_KIND_INT;
+    }
+    if (object == py_none) {
+        return NUMBER_KIND_NONE;
+    }
+    if (type == np_float64 || type == np_float32) {
+        int ok;
+        *doubleValue = unboxDouble(object, &ok);
+        return NUMBER_KIND_DOUBLE;
+    }
+    if (type == np_int64 || type == np_int32 || type == np_int16 || type == np_uint8 || type == np_bool) {
+        int ok;
+        *intValue = unboxLongInt(object, &ok);
+        return NUMBER_KIND_INT;
+    }
+    if (loadNumpyScalarTypes(type)) {
+        return classifyNumber(object, intValue, doubleValue);
+    }
+    return NUMBER_KIND_OTHER;
+}
+
+// The layout of NumPy's datetime64 and timedelta64 scalars (PyDatetimeScalarObject, PyTimedeltaScalarObject)
+typedef struct {
+    PyObject_HEAD
+    int64_t obval;
+    struct {
+        int base;   // NPY_DATETIMEUNIT
+        int num;
+    } obmeta;
+} NumpyTimeScalar;
+
+#define NPY_FR_W 2
+#define NPY_FR_ns 10
+#define NPY_FR_GENERIC 14
+
+// Nanoseconds per NumPy time unit, from weeks (NPY_FR_W) to nanoseconds (NPY_FR_ns); days are unit 4
+static const int64_t nanosecondsPerUnit[] = { 604800000000000LL, 0, 86400000000000LL, 3600000000000LL,
+                                              60000000000LL, 1000000000LL, 1000000LL, 1000LL, 1LL };
+
+static PyTypeObject* pd_timestamp;
+static PyTypeObject* pd_timedelta;
+static PyTypeObject* pd_nattype;
+
+void registerPandasTimeTypes(PyObject* timestamp, PyObject* timedelta, PyObject* nattype) {
+    pd_timestamp = (PyTypeObject*)timestamp;
+    pd_timedelta = (PyTypeObject*)timedelta;
+    pd_nattype = (PyTypeObject*)nattype;
+}
+
+// Sets *product to a * b, returning 0 if that overflows
+static int multiplyChecked(int64_t a, int64_t b, int64_t* product) {
+#if defined(_MSC_VER) && !defined(__clang__)
+    int64_t high;
+    *product = _mul128(a, b, &high);
+    return high == (*product < 0 ? -1 : 0);
+#else
+    return !__builtin_mul_overflow(a, b, product);
+#endif
+}
+
+int64_t unboxNanoseconds(PyObject* object, int timedelta, int* status) {
+    PyTypeObject* type = Py_TYPE(object);
+    loadNumpyScalarTypes(type);
+
+    if (type == (timedelta ? np_timedelta64 : np_datetime64)) {
+        NumpyTimeScalar* scalar = (NumpyTimeScalar*)object;
+        if (scalar->obval == INT64_MIN) {
+            *status = 1;    // NaT, in any unit
+            return INT64_MIN;
+        }
+        int base = scalar->obmeta.base;
+        if (base >= NPY_FR_W && base <= NPY_FR_ns && base != NPY_FR_W + 1) {
+            int64_t units, nanoseconds;
+            // INT64_MIN nanoseconds would read back as NaT, so it's out of range too
+            if (!multiplyChecked(scalar->obval, scalar->obmeta.num, &units) ||
+                !multiplyChecked(units, nanosecondsPerUnit[base - NPY_FR_W], &nanoseconds) ||
+                nanoseconds == INT64_MIN) {
+                (*pyerr_setstring)(pythonException("PyExc_OverflowError"), "time value is out of range for nanoseconds");
+                *status = 0;
+                return 0;
+            }
+            *status = 1;
+            return nanoseconds;
+        }
+        *status = -1;       // months, years or sub-nanosecond units
+        return 0;
+    }
+
+    if (type == (timedelta ? pd_timedelta : pd_timestamp) || type == pd_nattype) {
+        PyObject* value = (*pyobject_getattrstring)(object, "value");
+        if (value == NULL) {
+            *status = 0;
+            return 0;
+        }
+        long long nanoseconds = (*pylong_aslonglong)(value);
+        (*py_decref)(value);
+        *status = !(nanoseconds == -1 && (*pyerr_occurred)() != NULL);
+        return nanoseconds;
+    }
+
+    *status = -1;
+    return 0;
+}
+
+PyObject* boxNanoseconds(int64_t value, int timedelta) {
+    ensureNumpyScalarTypes();
+    PyTypeObject* type = timedelta ? np_timedelta64 : np_datetime64;
+    if (type == NULL) {
+        (*pyerr_setstring)(pythonException("PyExc_ImportError"), "numpy is required for datetime64 results");
+        return NULL;
+    }
+
+    NumpyTimeScalar* scalar = (NumpyTimeScalar*)type->tp_alloc(type, 0);
+    if (scalar == NULL) {
+        return NULL;
+    }
+    scalar->obval = value;
+    scalar->obmeta.base = NPY_FR_ns;
+    scalar->obmeta.num = 1;
+    return (PyObject*)scalar;
+}
+
+PyObject* boxLongInt(long int value) {
+    return (*pylong_fromlong)(value);
+}
+
+PyObject* boxDouble(double value) {
+    return (*pyfloat_fromdouble)(value);
+}
+
+PyObject* boxString(const char* value, long int length) {
+    return (*pyunicode_fromstringandsize)(value, length);
+}
+
+PyObject** listItems(PyObject* list, long int* count) {
+    *count = PyList_GET_SIZE(list);
+    return ((PyListObject*)list)->ob_item;
+}
+
+PyObject* listInOrder(PyObject* list, const long int* order, long int count) {
+    PyObject* result = (*pylist_new)(count);
+    if (result == NULL) {
+        return NULL;
+    }
+    for (long int i = 0; i < count; i++) {
+        PyObject* item = PyList_GET_ITEM(list, order[i]);
+        (*py_incref)(item);
+        PyList_SET_ITEM(result, i, item);
+    }
+    return result;
+}
+
+PyObject* packTuple(PyObject** items, long int count) {
+    long int i;
+    PyObject* tuple = NULL;
+    for (i = 0; i < count; i++) {
+        if (items[i] == NULL) goto fail;
+    }
+    tuple = (*pytuple_new)(count);
+    if (tuple == NULL) goto fail;
+    for (i = 0; i < count; i++) {
+        PyTuple_SET_ITEM(tuple, i, items[i]);
+    }
+    return tuple;
+
+fail:
+    for (i = 0; i < count; i++) {
+        if (items[i] != NULL) (*py_decref)(items[i]);
+    }
+    return NULL;
+}
+
+// A read-only mapping over Swift storage. The keys and values are boxed once, into tuples in the same order, and
+// the Swift `find` callback maps a key to its position; so a lookup never leaves native code.
+typedef struct {
+    PyObject_HEAD
+    void* storage;
+    MappingFindFunction find;
+    MappingReleaseFunction release;
+    PyObject* keys;
+    PyObject* values;
+} SwiftMapping;
+
+static PyTypeObject* swiftMappingType;
+
+// The value for `key`, as a borrowed reference, or NULL if it's missing
+static PyObject* mappingValue(SwiftMapping* mapping, PyObject* key) {
+    long int index = mapping->find(mapping->storage, key);
+    return index < 0 ? NULL : PyTuple_GET_ITEM(mapping->values, index);
+}
+
+static void mapping_dealloc(PyObject* self) {
+    SwiftMapping* mapping = (SwiftMapping*)self;
+    PyTypeObject* type = Py_TYPE(self);
+    mapping->release(mapping->storage);
+    (*py_decref)(mapping->keys);
+    (*py_decref)(mapping->values);
+    type->tp_free(self);
+    (*py_decref)((PyObject*)type);
+}
+
+static Py_ssize_t mapping_length(PyObject* self) {
+    return PyTuple_GET_SIZE(((SwiftMapping*)self)->keys);
+}
+
+static PyObject* mapping_subscript(PyObject* self, PyObject* key) {
+    PyObject* value = mappingValue((SwiftMapping*)self, key);
+    if (value == NULL) {
+        (*pyerr_setobject)(pythonException("PyExc_KeyError"), key);
+        return NULL;
+    }
+    (*py_incref)(value);
+    return value;
+}
+
+static int mapping_contains(PyObject* self, PyObject* key) {
+    return mappingValue((SwiftMapping*)self, key) != NULL;
+}
+
+static PyObject* mapping_iter(PyObject* self) {
+    return (*pyobject_getiter)(((SwiftMapping*)self)->keys);
+}
+
+static PyObject* mapping_get(PyObject* self, PyObject* args) {
+    PyObject* key;
+    PyObject* fallback = py_none;
+    if (!(*pyarg_parsetuple)(args, "O|O:get", &key, &fallback)) {
+        return NULL;
+    }
+    PyObject* value = mappingValue((SwiftMapping*)self, key);
+    value = value == NULL ? fallback : value;
+    (*py_incref)(value);
+    return value;
+}
+
+static PyObject* mapping_lookup(PyObject* self, PyObject* args) {
+    PyObject* column;
+    PyObject* fallback = py_none;
+    if (!(*pyarg_parsetuple)(args, "O|O:lookup", &column, &fallback)) {
+        return NULL;
+    }
+    PyObject* keys = (*pysequence_fast)(column, "lookup() needs an iterable of keys");
+    if (keys == NULL) {
+        return NULL;
+    }
+    Py_ssize_t count = PySequence_Fast_GET_SIZE(keys);
+    PyObject** items = PySequence_Fast_ITEMS(keys);
+    PyObject* result = (*pylist_new)(count);
+    if (result != NULL) {
+        for (Py_ssize_t i = 0; i < count; i++) {
+            PyObject* value = mappingValue((SwiftMapping*)self, items[i]);
+            value = value == NULL ? fallback : value;
+            (*py_incref)(value);
+            PyList_SET_ITEM(result, i, value);
+        }
+    }
+    (*py_decref)(keys);
+    return result;
+}
+
+static PyObject* mapping_list(PyObject* tuple) {
+    Py_ssize_t count = PyTuple_GET_SIZE(tuple);
+    PyObject* list = (*pylist_new)(count);
+    if (list == NULL) {
+        return NULL;
+    }
+    for (Py_ssize_t i = 0; i < count; i++) {
+        PyObject* item = PyTuple_GET_ITEM(tuple, i);
+        (*py_incref)(item);
+        PyList_SET_ITEM(list, i, item);
+    }
+    return list;
+}
+
+static PyObject* mapping_keys(PyObject* self, PyObject* unused) {
+    (void)unused;
+    return mapping_list(((SwiftMapping*)self)->keys);
+}
+
+static PyObject* mapping_values(PyObject* self, PyObject* unused) {
+    (void)unused;
+    return mapping_list(((SwiftMapping*)self)->values);
+}
+
+static PyObject* mapping_items(PyObject* self, PyObject* unused) {
+    (void)unused;
+    SwiftMapping* mapping = (SwiftMapping*)self;
+    Py_ssize_t count = PyTuple_GET_SIZE(mapping->keys);
+    PyObject* list = (*pylist_new)(count);
+    if (list == NULL) {
+        return NULL;
+    }
+    for (Py_ssize_t i = 0; i < count; i++) {
+        PyObject* item = (*py_buildvalue)("(OO)", PyTuple_GET_ITEM(mapping->keys, i), PyTuple_GET_ITEM(mapping->values, i));
+        if (item == NULL) {
+            (*py_decref)(list);
+            return NULL;
+        }
+        PyList_SET_ITEM(list, i, item);
+    }
+    return list;
+}
+
+static PyMethodDef mappingMethods[] = {
+    { "get", mapping_get, METH_VARARGS, "get(key, default=None): the value for key if it's present, else default" },
+    { "lookup", mapping_lookup, METH_VARARGS, "lookup(keys, default=None): a list of the value for each key, or default where it's missing" },
+    { "keys", mapping_keys, METH_NOARGS, "a list of the keys" },
+    { "values", mapping_values, METH_NOARGS, "a list of the values" },
+    { "items", mapping_items, METH_NOARGS, "a list of the (key, value) pairs" },
+    { NULL, NULL, 0, NULL }
+};
+
+static PyType_Slot mappingSlots[] = {
+    { Py_tp_dealloc, mapping_dealloc },
+    { Py_tp_iter, mapping_iter },
+    { Py_tp_methods, mappingMethods },
+    { Py_tp_doc, "A read-only mapping over a Swift dictionary" },
+    { Py_mp_length, mapping_length },
+    { Py_mp_subscript, mapping_subscript },
+    { Py_sq_length, mapping_length },
+    { Py_sq_contains, mapping_contains },
+    { 0, NULL }
+};
+
+static PyType_Spec mappingSpec = {
+    "pythonlambda.SwiftMapping", sizeof(SwiftMapping), 0, Py_TPFLAGS_DEFAULT, mappingSlots
+};
+
+PyObject* newSwiftMapping(void* storage, MappingFindFunction find, MappingReleaseFunction release,
+                          PyObject* keys, PyObject* values) {
+    if (swiftMappingType == NULL) {
+        swiftMappingType = (PyTypeObject*)(*pytype_fromspec)(&mappingSpec);
+        if (swiftMappingType == NULL) {
+            return NULL;
+        }
+        // no tp_new: mappings can only be created from Swift
+        swiftMappingType->tp_new = NULL;
+    }
+    SwiftMapping* mapping = (SwiftMapping*)swiftMappingType->tp_alloc(swiftMappingType, 0);
+    if (mapping == NULL) {
+        return NULL;
+    }
+    (*py_incref)(keys);
+    (*py_incref)(values);
+    mapping->storage = storage;
+    mapping->find = find;
+    mapping->release = release;
+    mapping->keys = keys;
+    mapping->values = values;
+    return (PyObject*)mapping;
+}
+
 /*
 PyObject* createModuleFunc(PyMethodDef* methodDef, const char* name) {
     const char *mymodule = "__builtin__";
@@ -169,6 +782,131 @@ PyObject* createPyCFunction(PyMethodDef* ml, PyObject* data) {
     return (*py_createPyCFunction)(ml, data, NULL);
 }
 
+void incRef(PyObject* object) {
+    (*py_incref)(object);
+}
+
+void decRef(PyObject* object) {
+    (*py_decref)(object);
+}
+
+PyObject* internString(const char* value) {
+    return (*pyunicode_internfromstring)(value);
+}
+
+static Py_ssize_t findParameter(PyObject* keyword, PyObject* const* names, Py_ssize_t nparams) {
+    // keyword names at call sites are normally interned, so identity usually suffices
+    for (Py_ssize_t i = 0; i < nparams; i++) {
+        if (names[i] == keyword) {
+            return i;
+        }
+    }
+    for (Py_ssize_t i = 0; i < nparams; i++) {
+        if ((*pyunicode_compare)(names[i], keyword) == 0) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+int bindFastcallArguments(PyObject* const* args, Py_ssize_t nargs, PyObject* kwnames,
+                          PyObject* const* names, Py_ssize_t nparams, PyObject** bound) {
+    char message[256];
+    
+    if (nargs > nparams) {
+        snprintf(message, sizeof(message), "takes at most %zd positional arguments (%zd given)", nparams, nargs);
+        raisePythonError("PyExc_TypeError", message);
+        return 0;
+    }
+    for (Py_ssize_t i = 0; i < nparams; i++) {
+        bound[i] = i < nargs ? args[i] : NULL;
+    }
+    if (kwnames == NULL) {
+        return 1;
+    }
+    
+    Py_ssize_t nkwargs = PyTuple_GET_SIZE(kwnames);
+    for (Py_ssize_t k = 0; k < nkwargs; k++) {
+        PyObject* keyword = PyTuple_GET_ITEM(kwnames, k);
+        Py_ssize_t i = findParameter(keyword, names, nparams);
+        if (i < 0) {
+            snprintf(message, sizeof(message), "got an unexpected keyword argument '%s'", (*pyunicode_asutf8)(keyword));
+            raisePythonError("PyExc_TypeError", message);
+            return 0;
+        }
+        if (bound[i] != NULL) {
+            snprintf(message, sizeof(message), "got multiple values for argument '%s'", (*pyunicode_asutf8)(keyword));
+            raisePythonError("PyExc_TypeError", message);
+            return 0;
+        }
+        bound[i] = args[nargs + k];
+    }
+    return 1;
+}
+
+int acquireGIL(void) {
+    return (*pygilstate_ensure)();
+}
+
+void releaseGIL(int state) {
+    (*pygilstate_release)(state);
+}
+
+void* saveThread(void) {
+    return (*pyeval_savethread)();
+}
+
+void restoreThread(void* threadState) {
+    (*pyeval_restorethread)(threadState);
+}
+
+void beforeFork(void) {
+    (*pyos_beforefork)();
+}
+
+void afterForkInParent(void) {
+    (*pyos_afterfork_parent)();
+}
+
+void afterForkInChild(void) {
+    (*pyos_afterfork_child)();
+}
+
+void raisePythonError(const char* exceptionName, const char* message) {
+    PyObject* exception = pythonException(exceptionName);
+    if (exception == NULL) {
+        exception = pythonException("PyExc_RuntimeError");
+    }
+    (*pyerr_setstring)(exception, message);
+}
+
+void clearPythonError(void) {
+    (*pyerr_clear)();
+}
+
+int getBuffer(PyObject* object, Py_buffer* view, int writable) {
+    int flags = PyBUF_STRIDES | PyBUF_FORMAT | (writable ? PyBUF_WRITABLE : 0);
+    return (*pyobject_getbuffer)(object, view, flags) == 0;
+}
+
+int getContiguousBuffer(PyObject* object, Py_buffer* view) {
+    return (*pyobject_getbuffer)(object, view, PyBUF_SIMPLE) == 0;
+}
+
+PyObject* newBytes(long int count, char** contents) {
+    PyObject* bytes = (*pybytes_fromstringandsize)(NULL, count);
+    *contents = bytes == NULL ? NULL : PyBytes_AS_STRING(bytes);
+    return bytes;
+}
+
+PyObject* boxBytes(const char* contents, long int count) {
+    return (*pybytes_fromstringandsize)(contents, count);
+}
+
+void releaseBuffer(Py_buffer* view) {
+    (*pybuffer_release)(view);
+}
+
 void debug_showAddress(const char* varName, void* value) {
     printf("variable %s has value %#llx\n", varName, (unsigned long long)value);
 }
@@ -19,6 +19,7 @@ PyObject* parseArgsToObject(PyObject *args, long int *error);
 double parseArgsToDouble(PyObject *args, long int *error);
 PyObject* parseArgsToObjectPair(PyObject *args, PyObject **objectB, long int *error);
 PyObject* parseArgsToObjectTriple(PyObject *args, PyObject **objectB, PyObject **objectC,  long int *error);
+PyObject* parseArgsToObjectAndOptionalObject(PyObject *args, PyObject **objectB, long int *error);
 
 PyObject* wrapLongInt(long int value);
 PyObject* wrapString(const char* value);
@@ -26,12 +27,87 @@ PyObject* wrapObject(PyObject* value);
 PyObject* wrapDouble(double value);
 PyObject* wrapBool(long int value);
 
+// Direct conversions for single objects, without going through format strings. The unboxers set *ok to 0, with
+// a Python exception set, on failure; unboxString returns NULL on failure. The boxers return new references.
+long int unboxLongInt(PyObject* object, int* ok);
+double unboxDouble(PyObject* object, int* ok);
+long int unboxBool(PyObject* object, int* ok);
+const char* unboxString(PyObject* object, long int* length);
+PyObject* boxLongInt(long int value);
+PyObject* boxDouble(double value);
+PyObject* boxString(const char* value, long int length);
+// Classifies an int, float or None (including NumPy integer and floating scalars) by its exact type, unboxing
+// ints into *intValue and floats into *doubleValue. NUMBER_KIND_ERROR means a Python exception is set, eg if an int
+// is too large.
+#define NUMBER_KIND_ERROR -1
+#define NUMBER_KIND_OTHER 0
+#define NUMBER_KIND_INT 1
+#define NUMBER_KIND_DOUBLE 2
+#define NUMBER_KIND_NONE 3
+int classifyNumber(PyObject* object, long int* intValue, double* doubleValue);
+
+// Nanosecond timestamps (timedelta == 0) and durations (timedelta == 1), from NumPy datetime64/timedelta64 scalars
+// or the registered pandas Timestamp/Timedelta/NaTType types. unboxNanoseconds sets *status to 1 on success, 0 with
+// a Python exception set (eg OverflowError, for a value out of range in nanoseconds), or -1 if the object isn't one
+// it can convert directly. boxNanoseconds returns a new datetime64[ns] or timedelta64[ns] scalar.
+void registerPandasTimeTypes(PyObject* timestamp, PyObject* timedelta, PyObject* nattype);
+int64_t unboxNanoseconds(PyObject* object, int timedelta, int* status);
+PyObject* boxNanoseconds(int64_t value, int timedelta);
+// The (borrowed) items of a list, which must not be modified while they're in use
+PyObject** listItems(PyObject* list, long int* count);
+// A new list of the items of `list` at the `count` indices in `order`, which must all be in range
+PyObject* listInOrder(PyObject* list, const long int* order, long int count);
+// Steals the references to the items. If any item is NULL (ie its boxing failed), the others are released and
+// NULL returned, leaving the Python exception set.
+PyObject* packTuple(PyObject** items, long int count);
+
+// A new read-only Python mapping over Swift storage, whose keys and values are the items of the tuples `keys` and
+// `values`, in the same order. `find` returns the position of a key, or -1 if it's missing (leaving no exception
+// set); `release` is called with the storage when the mapping is deallocated.
+typedef long int (*MappingFindFunction)(void* storage, PyObject* key);
+typedef void (*MappingReleaseFunction)(void* storage);
+PyObject* newSwiftMapping(void* storage, MappingFindFunction find, MappingReleaseFunction release,
+                          PyObject* keys, PyObject* values);
+
 // Shims for useful Python library functions
 //PyCFunction copyPyCFnPtr(PyCFunction p);
 //PyObject* createModuleFunc(PyMethodDef* methodDef, const char* name);
 const char* stringFromPythonObject(PyObject* p);
 PyObject * getPyUnicode_FromString (const char *u);
 PyObject* createPyCFunction(PyMethodDef* ml, PyObject* data);
+void incRef(PyObject* object);
+void decRef(PyObject* object);
+PyObject* internString(const char* value);
+
+// Binds METH_FASTCALL | METH_KEYWORDS arguments to the (interned) parameter names, storing borrowed references
+// in bound, and NULL for parameters not supplied. Returns 1 on success, or 0 with a TypeError set.
+int bindFastcallArguments(PyObject* const* args, Py_ssize_t nargs, PyObject* kwnames,
+                          PyObject* const* names, Py_ssize_t nparams, PyObject** bound);
+
+// GIL management, for calling back into Python from threads other than the interpreter's
+int acquireGIL(void);
+void releaseGIL(int state);
+void* saveThread(void);
+void restoreThread(void* threadState);
+
+// Interpreter housekeeping around a fork() made outside Python's own os.fork
+void beforeFork(void);
+void afterForkInParent(void);
+void afterForkInChild(void);
+
+// Sets the Python error indicator, eg raisePythonError("PyExc_TypeError", "expected a float")
+void raisePythonError(const char* exceptionName, const char* message);
+void clearPythonError(void);
+
+// Buffer protocol: returns 1 on success, or 0 with a Python exception set. Strided buffers are accepted.
+int getBuffer(PyObject* object, Py_buffer* view, int writable);
+void releaseBuffer(Py_buffer* view);
+// A contiguous, read-only view of the object's bytes, eg of bytes, bytearray or a contiguous memoryview
+int getContiguousBuffer(PyObject* object, Py_buffer* view);
+
+// A new bytes object of `count` uninitialised bytes, to be filled through *contents before it's shared; or NULL
+PyObject* newBytes(long int count, char** contents);
+PyObject* boxBytes(const char* contents, long int count);
 
 void debug_showAddress(const char* varName, void* value);
 
@@ -106,6 +106,539 @@ class PythonLambdaTests: XCTestCase {
         XCTAssertEqual(added, [15, 17, 19])
     }
     
+    func testLambdaPickles() {
+        let pickle = Python.import("pickle")
+        let tripler = 𝝺{x in x*3}
+        
+        let restored = pickle.loads(pickle.dumps(tripler))
+        XCTAssertEqual(restored(5), 15)
+        
+        // ordinary builtins still pickle as before
+        XCTAssertEqual(pickle.loads(pickle.dumps(Python.len))([1, 2]), 2)
+    }
+    
+    func testLambdaInForkedPool() {
+        let squarer = 𝝺{(x:Int) in x*x}
+        let pool = Python.import("multiprocessing").get_context("fork").Pool(processes: 2)
+        let squares = pool.map(squarer, [1, 2, 3, 4])
+        pool.close()
+        pool.join()
+        
+        XCTAssertEqual(Array<Int>(squares), [1, 4, 9, 16])
+    }
+    
+    func testBatchLambda() {
+        let np = Python.import("numpy")
+        let doubler = 𝝺(batch: {(x:Double) in x*2})
+        
+        XCTAssertEqual(Array<Double>(doubler.pythonObject(np.arange(4.0)).tolist()), [0, 2, 4, 6])
+        
+        let out = np.zeros(3, dtype: "bool")
+        let isBig = 𝝺(batch: {(x:Int) in x > 10})
+        _ = isBig.pythonObject(np.array([5, 50, 500]), out)
+        XCTAssertEqual(Array<Bool>(out.tolist()), [false, true, true])
+    }
+    
+    func testApplyInProcesses() {
+        let np = Python.import("numpy")
+        let halved = PythonLambda.applyInProcesses({(x:Int) in Double(x)/2}, to: np.arange(1000), processes: 2)
+        
+        XCTAssertEqual(Int(halved.size), 1000)
+        XCTAssertEqual(Double(halved[999]), 499.5)
+        XCTAssertEqual(Double(halved.sum()), 249750)
+    }
+    
+    func testKeywordLambda() {
+        let scaler = 𝝺(parameters: ["x", "scale", "offset"], defaults: ["offset": 0]) { args in
+            args[0] * args[1] + args[2]
+        }.pythonObject
+        
+        XCTAssertEqual(scaler(3, 2), 6)
+        XCTAssertEqual(scaler(3, scale: 2, offset: 1), 7)
+        XCTAssertEqual(scaler(offset: 1, scale: 10, x: 3), 31)
+        XCTAssertThrowsError(try scaler.throwing.dynamicallyCall(withKeywordArguments: ["x": 3]))
+        XCTAssertThrowsError(try scaler.throwing.dynamicallyCall(withKeywordArguments: ["x": 3, "scale": 1, "colour": 2]))
+    }
+    
+    func testTypedMultiArgumentLambda() {
+        let functools = Python.import("functools")
+        let adder = 𝝺{(x:Double, y:Double) in x+y}
+        XCTAssertEqual(functools.reduce(adder, [1.5, 2, 3.5], 0.0), 7.0)
+
+        let between = 𝝺{(x:Int, low:Int, high:Int) in low <= x && x <= high}.pythonObject
+        XCTAssertEqual(between(5, 1, 10), true)
+        XCTAssertEqual(between(0, 1, 10), false)
+        XCTAssertThrowsError(try between.throwing.dynamicallyCall(withArguments: 5, 1))
+        XCTAssertThrowsError(try between.throwing.dynamicallyCall(withArguments: "5", 1, 10))
+
+        let label = 𝝺{(name:String, n:Int, flag:Bool, w:Double, x:Double, y:Double) in "\(name)\(n)\(flag)\(w+x+y)"}
+        XCTAssertEqual(label.pythonObject("ab", 3, true, 1.0, 2, 3), "ab3true6.0")
+    }
+
+    func testNarrowNumericLambdas() {
+        let np = Python.import("numpy")
+        let celsius = 𝝺{(f:Float) in (f - 32) * 5 / 9}.pythonObject
+        XCTAssertEqual(celsius(212), 100.0)
+
+        let brighten = 𝝺{(p:UInt8) in p &+ 1}.pythonObject
+        XCTAssertEqual(brighten(254), 255)
+        XCTAssertThrowsError(try brighten.throwing.dynamicallyCall(withArguments: 256))
+
+        let scaled = 𝝺(batch: {(x:Float) in x*2}).pythonObject(np.arange(4, dtype: "float32"))
+        XCTAssertEqual(scaled.dtype, np.dtype("float32"))
+        XCTAssertEqual(scaled.tolist(), [0.0, 2.0, 4.0, 6.0])
+
+        let inverted = 𝝺(batch: {(p:UInt8) in 255 - p}).pythonObject(np.array([0, 55, 255], dtype: "uint8"))
+        XCTAssertEqual(inverted.dtype, np.dtype("uint8"))
+        XCTAssertEqual(inverted.tolist(), [255, 200, 0])
+    }
+
+    func testTupleLambda() {
+        let np = Python.import("numpy")
+        let parsed = 𝝺{(s:String) in (s.count, s.uppercased())}.pythonObject
+        XCTAssertEqual(parsed("abc"), PythonObject(tupleOf: 3, "ABC"))
+
+        let split = 𝝺(batch: {(x:Double) in (x.rounded(.towardZero), Int(x * 10) % 10)})
+        let (whole, tenths) = split.pythonObject(np.array([1.5, 2.25, -3.75])).tuple2
+        XCTAssertEqual(whole.tolist(), [1.0, 2.0, -3.0])
+        XCTAssertEqual(tenths.tolist(), [5, 2, -7])
+        XCTAssertEqual(tenths.dtype, np.dtype("int64"))
+    }
+
+    func testNumpyScalarArguments() {
+        let np = Python.import("numpy")
+        let halver = 𝝺{(x:Double) in x/2}.pythonObject
+        XCTAssertEqual(halver(np.float64(3)), 1.5)
+        XCTAssertEqual(halver(np.float32(5)), 2.5)
+        XCTAssertEqual(halver(np.int64(7)), 3.5)
+
+        let incrementer = 𝝺{(x:Int) in x+1}.pythonObject
+        XCTAssertEqual(incrementer(np.int64(41)), 42)
+        XCTAssertEqual(incrementer(np.uint8(255)), 256)
+        XCTAssertThrowsError(try incrementer.throwing.dynamicallyCall(withArguments: np.float64(1.5)))
+
+        let both = 𝝺{(a:Bool, b:Bool) in a && b}.pythonObject
+        XCTAssertEqual(both(np.bool_(true), np.bool_(false)), false)
+    }
+
+    func testTimeLambdas() {
+        let np = Python.import("numpy")
+        let pd = Python.import("pandas")
+        let times = pd.Series(pd.to_datetime(["2026-10-17 09:15", "2026-10-17 10:45"]))
+
+        let hourly = 𝝺{(t:PythonInstant) in t.rounded(down: .hours(1))}
+        let buckets = times.apply(hourly)
+        XCTAssertEqual(buckets.dtype, np.dtype("datetime64[ns]"))
+        XCTAssertEqual(buckets[1], pd.Timestamp("2026-10-17 10:00"))
+
+        let elapsed = 𝝺{(start:PythonInstant, end:PythonInstant) in end - start}.pythonObject
+        XCTAssertEqual(elapsed(times[0], times[1]), pd.Timedelta(minutes: 90))
+
+        let later = 𝝺(batch: {(t:PythonInstant) in t + .minutes(30)}).pythonObject(times.values)
+        XCTAssertEqual(later.dtype, np.dtype("datetime64[ns]"))
+        XCTAssertEqual(later[0], np.datetime64("2026-10-17T09:45", "ns"))
+
+        // dates too far from the epoch for nanoseconds raise OverflowError rather than wrapping
+        let sinceEpoch = 𝝺{(t:PythonInstant) in t.nanoseconds}.pythonObject
+        XCTAssertEqual(sinceEpoch(np.datetime64("2200-01-01", "D")), 7258118400000000000)
+        XCTAssertThrowsError(try sinceEpoch.throwing.dynamicallyCall(withArguments: np.datetime64("2300-01-01", "D")))
+
+        // NaT, and results out of range, give NaT rather than trapping
+        let earlier = 𝝺(batch: {(t:PythonInstant) in t - .minutes(30)}).pythonObject(pd.to_datetime([Python.None, "2026-10-17 09:15"]).values)
+        XCTAssertTrue(Bool(np.isnat(earlier[0]))!)
+        XCTAssertEqual(earlier[1], np.datetime64("2026-10-17T08:45", "ns"))
+        XCTAssertTrue((PythonInstant.notATime + .minutes(1)).isNotATime)
+        XCTAssertTrue((PythonInstant(nanoseconds: 0) - PythonInstant.notATime).isNotATime)
+        XCTAssertTrue((PythonInstant(nanoseconds: .max - 1) + .seconds(1)).isNotATime)
+        XCTAssertTrue(PythonDuration.days(.max / 1000).isNotATime)
+
+        // so does rounding to a non-positive interval, instead of crashing the interpreter
+        let unrounded = 𝝺{(t:PythonInstant, minutes:Int) in t.rounded(down: .minutes(Int64(minutes)))}.pythonObject
+        XCTAssertTrue(Bool(pd.isna(unrounded(times[0], 0)))!)
+        XCTAssertTrue(Bool(pd.isna(unrounded(times[0], -15)))!)
+        XCTAssertEqual(unrounded(times[0], 15), np.datetime64("2026-10-17T09:15", "ns"))
+    }
+
+    func testBytesLambda() {
+        let length = 𝝺{(data:UnsafeRawBufferPointer) in data.count}.pythonObject
+        XCTAssertEqual(length(PythonBytes(count: 3) { $0.initializeMemory(as: UInt8.self, repeating: 7) }), 3)
+        XCTAssertEqual(length(Python.bytearray(5)), 5)
+        XCTAssertEqual(length(Python.memoryview(Python.bytes(4))), 4)
+        XCTAssertThrowsError(try length.throwing.dynamicallyCall(withArguments: "text"))
+
+        let reversed = 𝝺{(data:UnsafeRawBufferPointer) in
+            PythonBytes(count: data.count) { out in
+                for i in 0..<data.count { out[i] = data[data.count - 1 - i] }
+            }
+        }.pythonObject
+        XCTAssertEqual(reversed(Python.bytes([1, 2, 3])), Python.bytes([3, 2, 1]))
+
+        let encoded = 𝝺{(s:String) in Array(s.utf8)}.pythonObject
+        XCTAssertEqual(encoded("abc"), Python.bytes([97, 98, 99]))
+    }
+
+    func testDispatchingLambda() {
+        let pd = Python.import("pandas")
+        let mixed = pd.Series([1, 2.5, Python.None, 4], dtype: "object")
+        let cleaned = 𝝺(onInt: { Double($0) }, onDouble: { $0 * 2 }, onNone: { -1.0 })
+        XCTAssertEqual(mixed.apply(cleaned).tolist(), [1.0, 5.0, -1.0, 4.0])
+
+        XCTAssertThrowsError(try cleaned.pythonObject.throwing.dynamicallyCall(withArguments: "x"))
+        let lenient = 𝝺(onInt: { $0 }, onDouble: { Int($0) }, onNone: { 0 }, onOther: { _ in -1 }).pythonObject
+        XCTAssertEqual(lenient("x"), -1)
+    }
+
+    func testAggregator() {
+        let pd = Python.import("pandas")
+        let df = pd.DataFrame(["k": ["b", "a", "b", Python.None, "a", "b"], "x": [1.0, 2.0, 3.0, 100.0, 4.0, 5.0]])
+
+        for parallel in [false, true] {
+            let spread = PythonAggregator(parallel: parallel) { values in values.max()! - values.min()! }
+            let result = spread.aggregate(df.x, by: df.k)
+            XCTAssertEqual(result.index.tolist(), ["a", "b"])
+            XCTAssertEqual(result.tolist(), [2.0, 4.0])
+            XCTAssertEqual(result.name, "x")
+        }
+    }
+
+    func testHashAggregation() {
+        let pd = Python.import("pandas")
+        let df = pd.DataFrame(["name": ["ab", "cde", "fg", "h"], "price": [1.0, 2.0, 3.0, 4.0]])
+
+        let result = PythonLambda.aggregate(keys: df.name, by: {(s:String) in s.count},
+                                            values: df.price, {(p:Double) in p * 2},
+                                            [.sum, .count, .max, .mean])
+        XCTAssertEqual(result.index.tolist(), [2, 3, 1])
+        XCTAssertEqual(result.columns.tolist(), ["sum", "count", "max", "mean"])
+        XCTAssertEqual(result["sum"].tolist(), [8.0, 4.0, 8.0])
+        XCTAssertEqual(result["count"].tolist(), [2, 1, 1])
+        XCTAssertEqual(result.loc[2, "mean"], 4.0)
+    }
+
+    func testRollingLambda() {
+        struct RollingSum: PythonRollingLambda {
+            var sum = 0.0
+            mutating func add(_ value: Double) { sum += value }
+            mutating func remove(_ value: Double) { sum -= value }
+            func value() -> Double { sum }
+        }
+        let pd = Python.import("pandas")
+        let np = Python.import("numpy")
+        let xs = pd.Series([1.0, 2.0, Double.nan, 4.0, 5.0])
+
+        let fixed = RollingSum().rolling(xs, window: 2, minPeriods: 1)
+        XCTAssertEqual(fixed.tolist(), xs.rolling(2, min_periods: 1).sum().tolist())
+
+        let times = pd.to_datetime(["2026-10-17 09:00", "2026-10-17 09:01", "2026-10-17 09:02",
+                                    "2026-10-17 09:04", "2026-10-17 09:05"])
+        let timed = RollingSum().rolling(xs, window: .minutes(2), times: times)
+        XCTAssertEqual(timed.tolist(), [1.0, 3.0, 2.0, 4.0, 9.0])
+        let gappy = pd.to_datetime([Python.None, "2026-10-17 09:01", Python.None, "2026-10-17 09:02", "2026-10-17 09:04"])
+        let skipped = RollingSum().rolling(xs, window: .minutes(2), times: gappy)
+        XCTAssertTrue(Double(skipped[0])!.isNaN)
+        XCTAssertTrue(Double(skipped[2])!.isNaN)
+        XCTAssertEqual([Double(skipped[1])!, Double(skipped[3])!, Double(skipped[4])!], [2.0, 6.0, 5.0])
+        let plain = RollingSum().rolling(np.arange(3.0), window: 2)
+        XCTAssertTrue(Double(plain[0])!.isNaN)
+        XCTAssertEqual([Double(plain[1])!, Double(plain[2])!], [1.0, 3.0])
+    }
+
+    func testScan() {
+        let np = Python.import("numpy")
+        let pd = Python.import("pandas")
+        let xs = np.random.default_rng(1).integers(-5, 10, 200_000)
+
+        let running = PythonLambda.scan(xs) { (a:Int, b:Int) in a + b }
+        XCTAssertTrue(Bool(np.array_equal(running, np.cumsum(xs)))!)
+
+        let before = PythonLambda.scan(xs, exclusive: true, identity: 0) { (a:Int, b:Int) in a + b }
+        XCTAssertEqual(before[0], 0)
+        XCTAssertTrue(Bool(np.array_equal(before + xs, np.cumsum(xs)))!)
+
+        let prices = pd.Series([3.0, 1.0, 4.0, 1.0, 5.0], name: "price")
+        let highs = PythonLambda.scan(prices) { (a:Double, b:Double) in max(a, b) }
+        XCTAssertEqual(highs.tolist(), [3.0, 3.0, 4.0, 4.0, 5.0])
+        XCTAssertEqual(highs.name, "price")
+    }
+
+    func testSortByKey() {
+        let names: PythonObject = ["kiwi", "fig", "banana", "apple", "date"]
+        XCTAssertEqual(PythonLambda.sorted(names, key: {(s:String) in s.count}),
+                       ["fig", "kiwi", "date", "apple", "banana"])
+        XCTAssertEqual(PythonLambda.sorted(names, key: {(s:String) in s.count}, reverse: true),
+                       ["banana", "apple", "kiwi", "date", "fig"])
+        XCTAssertEqual(PythonLambda.argsort(names, key: {(s:String) in s}).tolist(), [3, 2, 4, 1, 0])
+
+        // large enough to be sorted in parallel runs
+        let np = Python.import("numpy")
+        let xs = np.random.default_rng(2).integers(0, 1000, 100_000)
+        let order = PythonLambda.argsort(xs, key: {(x:Int) in x % 100})
+        XCTAssertTrue(Bool(np.array_equal(order, np.argsort(xs % 100, kind: "stable")))!)
+    }
+
+    func testMapping() {
+        let codes = PythonMapping(["north": 1, "south": 2, "éast": 3])
+        let m = codes.pythonObject
+        XCTAssertEqual(m["south"], 2)
+        XCTAssertEqual(m["éast"], 3)
+        XCTAssertEqual(Python.len(m), 3)
+        XCTAssertTrue(Bool(m.__contains__("north"))!)
+        XCTAssertFalse(Bool(m.__contains__("west"))!)
+        XCTAssertFalse(Bool(m.__contains__(1))!)
+        XCTAssertEqual(m.get("west", -1), -1)
+        XCTAssertEqual(Python.sorted(m), ["north", "south", "éast"])
+        XCTAssertEqual(Python.dict(m), ["north": 1, "south": 2, "éast": 3])
+        XCTAssertFalse(Bool(Python.isinstance(m, Python.import("collections.abc").Mapping))!)
+
+        let pd = Python.import("pandas")
+        let regions = pd.Series(["south", "west", "north"], index: [10, 20, 30])
+        let looked = codes.lookup(regions, default: -1)
+        XCTAssertEqual(looked.tolist(), [2, -1, 1])
+        XCTAssertEqual(looked.index.tolist(), [10, 20, 30])
+
+        let squares = PythonMapping(Dictionary(uniqueKeysWithValues: (0..<100).map { ($0, Double($0 * $0)) }))
+        XCTAssertEqual(squares.pythonObject.lookup([3, 200, 9]), [9.0, Python.None, 81.0])
+    }
+
+    func testApplyAlongAxis() {
+        let np = Python.import("numpy")
+        let pd = Python.import("pandas")
+        let a = np.arange(650.0).reshape(50, 13)
+        let sum = { (line:StridedBufferView<Double>) in line.reduce(0, +) }
+
+        for layout in [a, np.asfortranarray(a)] {
+            XCTAssertTrue(Bool(np.array_equal(PythonLambda.applyAlongAxis(layout, axis: .rows, sum), a.sum(axis: 1)))!)
+            XCTAssertTrue(Bool(np.array_equal(PythonLambda.applyAlongAxis(layout, axis: .columns, sum), a.sum(axis: 0)))!)
+        }
+
+        let df = pd.DataFrame(["x": [1, 2, 3], "y": [10.5, 20.5, 30.5]], index: ["a", "b", "c"])
+        let largest = PythonLambda.applyAlongAxis(df, axis: .rows) { (row:StridedBufferView<Double>) in Int(row.max()!) }
+        XCTAssertEqual(largest.tolist(), [10, 20, 30])
+        XCTAssertEqual(largest.index.tolist(), ["a", "b", "c"])
+        let firsts = PythonLambda.applyAlongAxis(df, axis: .columns) { (column:StridedBufferView<Double>) in column[0] }
+        XCTAssertEqual(firsts.tolist(), [1.0, 10.5])
+        XCTAssertEqual(firsts.index.tolist(), ["x", "y"])
+    }
+
+    func testFrameLambda() {
+        let pd = Python.import("pandas")
+        let names = pd.Series(["fig", "kiwi", "banana"], index: [7, 8, 9])
+
+        let parsed = 𝝺(frame: ("length", "upper"), {(s:String) in (s.count, s.uppercased())})
+        let features = parsed.pythonObject(names)
+        XCTAssertEqual(features.columns.tolist(), ["length", "upper"])
+        XCTAssertEqual(features.index.tolist(), [7, 8, 9])
+        XCTAssertEqual(features.length.tolist(), [3, 4, 6])
+        XCTAssertEqual(String(features.length.dtype), "int64")
+        XCTAssertEqual(features.upper.tolist(), ["FIG", "KIWI", "BANANA"])
+
+        let split = 𝝺(frame: ("whole", "fraction", "negative"), {(x:Double) in (x.rounded(.towardZero), abs(x.truncatingRemainder(dividingBy: 1)), x < 0)})
+        let parts = split.pythonObject(Python.list([1.25, -2.5]))
+        XCTAssertEqual(parts.whole.tolist(), [1.0, -2.0])
+        XCTAssertEqual(parts.fraction.tolist(), [0.25, 0.5])
+        XCTAssertEqual(parts.negative.tolist(), [false, true])
+    }
+
+    func testApplyColumns() {
+        let np = Python.import("numpy")
+        let pd = Python.import("pandas")
+        let df = pd.DataFrame(["a": [1.0, -5.0, 2.0], "b": [4.0, 5.0, -6.0], "c": [7, 8, 9]], index: ["x", "y", "z"])
+
+        let clipped = PythonLambda.applyColumns(df, columns: ["a", "b"]) { (x:Double) in min(max(x, -3), 3) }
+        XCTAssertEqual(clipped.columns.tolist(), ["a", "b"])
+        XCTAssertEqual(clipped.index.tolist(), ["x", "y", "z"])
+        XCTAssertEqual(clipped.a.tolist(), [1.0, -3.0, 2.0])
+        XCTAssertEqual(clipped.b.tolist(), [3.0, 3.0, -3.0])
+
+        let signs = PythonLambda.applyColumns(df) { (x:Double) in x < 0 }
+        XCTAssertEqual(signs.columns.tolist(), ["a", "b", "c"])
+        XCTAssertEqual(signs.b.tolist(), [false, false, true])
+
+        // large enough for each column to be split across cores
+        let wide = pd.DataFrame(np.random.default_rng(3).normal(size: PythonObject(tupleOf: 100_000, 3)))
+        let scaled = PythonLambda.applyColumns(wide) { (x:Double) in x * 2 }
+        XCTAssertTrue(Bool(np.array_equal(scaled.values, wide.values * 2))!)
+    }
+
+    func testFilterCompact() {
+        let np = Python.import("numpy")
+        let xs = np.array([5.0, 150.0, -2.0, 101.0, 100.0])
+        XCTAssertEqual(PythonLambda.filterCompact(xs) { (x:Double) in x > 100 }.tolist(), [150.0, 101.0])
+        XCTAssertEqual(PythonLambda.filterCompact(xs, indices: true) { (x:Double) in x > 100 }.tolist(), [1, 3])
+        XCTAssertEqual(Python.len(PythonLambda.filterCompact(xs) { (x:Double) in x > 1000 }), 0)
+
+        // large enough to be filtered in parallel chunks
+        let ys = np.random.default_rng(4).integers(0, 1000, 200_003)
+        let evens = PythonLambda.filterCompact(ys) { (y:Int) in y % 2 == 0 }
+        XCTAssertTrue(Bool(np.array_equal(evens, ys[ys % 2 == 0]))!)
+        let positions = PythonLambda.filterCompact(ys, indices: true) { (y:Int) in y < 10 }
+        XCTAssertTrue(Bool(np.array_equal(positions, np.flatnonzero(ys < 10)))!)
+    }
+
+    func testHistogram() {
+        let np = Python.import("numpy")
+        let ages = np.array([3, 15, 17, 42, 48, 49, 130])
+        XCTAssertEqual(PythonLambda.histogram(ages, buckets: 6) { (age:Int) in age / 10 }.tolist(), [1, 2, 0, 0, 3, 0])
+
+        let prices = np.array([0.0, 5.0, 10.0, 99.0, 100.0, 1000.0, 1001.0, -1.0, Double.nan])
+        XCTAssertEqual(PythonLambda.histogram(prices, edges: [0, 10, 100, 1000]).tolist(), [2, 2, 2])
+
+        // large enough to be counted in parallel chunks
+        let xs = np.random.default_rng(5).normal(size: 300_000)
+        let edges = [-4.0, -1, 0, 0.5, 1, 4]
+        XCTAssertTrue(Bool(np.array_equal(PythonLambda.histogram(xs, edges: edges), np.histogram(xs, bins: edges)[0]))!)
+    }
+
+    func testTabulatedLambdas() {
+        let np = Python.import("numpy")
+        var evaluations = 0
+        let label = 𝝺(tabulating: {(flag:Bool) -> String in evaluations += 1; return flag ? "yes" : "no"})
+        XCTAssertEqual(evaluations, 2)
+        XCTAssertEqual(Python.list(Python.map(label, [true, false, 1, 0])), ["yes", "no", "yes", "no"])
+        XCTAssertEqual(evaluations, 2)
+
+        let half = 𝝺(tabulating: {(x:UInt8) in Double(x) / 2})
+        XCTAssertEqual(half.pythonObject(255), 127.5)
+
+        let weekday = 𝝺(tabulating: {(d:Int) in ["Mon", "Tue", "Wed", "Thu", "Fri", "Sat", "Sun"][d]}, domain: 0...6)
+        XCTAssertEqual(weekday.pythonObject(3), "Thu")
+        Python.execute("""
+        def out_of_domain(f):
+            try:
+                f(7)
+                return False
+            except ValueError:
+                return True
+        """)
+        XCTAssertTrue(Bool(Python.import("__main__").out_of_domain(weekday))!)
+
+        let levels = 𝝺(batchTabulating: {(x:UInt8) in Double(x) / 255})
+        XCTAssertEqual(levels.pythonObject(np.array([0, 51, 255], dtype: "uint8")).tolist(), [0.0, 0.2, 1.0])
+
+        let squares = 𝝺(batchTabulating: {(x:Int) in x * x}, domain: -3...3)
+        XCTAssertEqual(squares.pythonObject(np.array([-3, 2, 0])).tolist(), [9, 4, 0])
+        XCTAssertTrue(Bool(Python.import("__main__").out_of_domain(squares))!)
+
+        XCTAssertTrue(PythonLambda.canTabulate(-3...3))
+        XCTAssertTrue(PythonLambda.canTabulate(0...(PythonLambda.maximumTabulatedDomain - 1)))
+        XCTAssertFalse(PythonLambda.canTabulate(0...PythonLambda.maximumTabulatedDomain))
+        XCTAssertFalse(PythonLambda.canTabulate(Int.min...Int.max))
+    }
+
+    func testIncrementalApply() {
+        let np = Python.import("numpy")
+        let pd = Python.import("pandas")
+        let doubled = PythonIncrementalApply(chunkSize: 4) { (x:Double) in x * 2 }
+
+        let xs = np.arange(10.0)
+        XCTAssertEqual(doubled.apply(xs).tolist(), (0..<10).map { Double($0 * 2) }.pythonObject)
+        XCTAssertEqual(doubled.recomputedChunks, 3)
+
+        XCTAssertEqual(doubled.apply(xs).tolist(), (0..<10).map { Double($0 * 2) }.pythonObject)
+        XCTAssertEqual(doubled.recomputedChunks, 0)
+
+        // appending rows recomputes the last, partial, chunk and the new ones
+        let longer = np.arange(13.0)
+        XCTAssertEqual(doubled.apply(longer).tolist(), (0..<13).map { Double($0 * 2) }.pythonObject)
+        XCTAssertEqual(doubled.recomputedChunks, 2)
+
+        // changing a row recomputes just its chunk
+        longer[5] = 100
+        let series = pd.Series(longer, index: np.arange(13) + 1)
+        let result = doubled.apply(series)
+        XCTAssertEqual(result[6], 200.0)
+        XCTAssertEqual(result[13], 24.0)
+        XCTAssertEqual(doubled.recomputedChunks, 1)
+
+        // as does shortening the column, for its last chunk
+        XCTAssertEqual(doubled.apply(np.arange(6.0)).tolist(), [0.0, 2.0, 4.0, 6.0, 8.0, 10.0])
+        XCTAssertEqual(doubled.recomputedChunks, 1)
+
+        doubled.reset()
+        _ = doubled.apply(np.arange(6.0))
+        XCTAssertEqual(doubled.recomputedChunks, 2)
+    }
+
+    #if compiler(>=5.5) && canImport(_Concurrency)
+    func testAsyncLambda() throws {
+        guard #available(macOS 10.15, *) else { throw XCTSkip("async lambdas need macOS 10.15") }
+        
+        let slowDoubler = 𝝺(awaiting: { (x:Int) async -> Int in
+            try? await Task.sleep(nanoseconds: 1_000_000)
+            return x*2
+        })
+        
+        Python.execute("""
+        import asyncio
+        async def gather_lambda(f, xs):
+            return await asyncio.gather(*[f(x) for x in xs])
+        """)
+        
+        let main = Python.import("__main__")
+        let results = Python.import("asyncio").run( main.gather_lambda(slowDoubler, [1, 2, 3]) )
+        XCTAssertEqual(Array<Int>(results), [2, 4, 6])
+    }
+    
+    func testExecutorBatchesWork() throws {
+        guard #available(macOS 10.15, *) else { throw XCTSkip("PythonExecutor needs macOS 10.15") }
+        
+        let executor = PythonExecutor(maxBatchSize: 64)
+        defer { executor.shutdown() }
+        let done = expectation(description: "all jobs complete")
+        final class Results { var lengths: [Int] = [] }
+        let results = Results()
+        
+        Task {
+            results.lengths = try await withThrowingTaskGroup(of: Int.self) { group in
+                for n in 0..<200 {
+                    group.addTask { try await executor.run { Int(Python.len(Python.range(n)))! } }
+                }
+                return try await group.reduce(into: []) { $0.append($1) }
+            }
+            done.fulfill()
+        }
+        
+        // the test thread holds the GIL, so the executor is blocked on its first batch (of at most 64 jobs): wait
+        // until plenty more have queued up behind it, then give up the GIL so they run
+        let deadline = Date().addingTimeInterval(30)
+        while executor.metrics.queueDepth < 100 && Date() < deadline {
+            Thread.sleep(forTimeInterval: 0.001)
+        }
+        PythonGIL.withoutGIL { wait(for: [done], timeout: 30) }
+        
+        XCTAssertEqual(results.lengths.sorted(), Array(0..<200))
+        let metrics = executor.metrics
+        XCTAssertEqual(metrics.jobsRun, 200)
+        XCTAssertLessThan(metrics.batchesRun, metrics.jobsRun)
+        XCTAssertGreaterThan(metrics.averageBatchSize, 1)
+        XCTAssertEqual(metrics.queueDepth, 0)
+    }
+    
+    func testExecutorShutdown() throws {
+        guard #available(macOS 10.15, *) else { throw XCTSkip("PythonExecutor needs macOS 10.15") }
+        
+        let executor = PythonExecutor()
+        let done = expectation(description: "jobs complete")
+        final class Outcome { var value = 0; var rejected = false }
+        let outcome = Outcome()
+        
+        Task {
+            outcome.value = try await executor.run { Int(Python.len(Python.range(3)))! }
+            executor.shutdown()
+            do {
+                _ = try await executor.run { 0 }
+            } catch is CancellationError {
+                outcome.rejected = true
+            }
+            done.fulfill()
+        }
+        
+        PythonGIL.withoutGIL { wait(for: [done], timeout: 30) }
+        XCTAssertEqual(outcome.value, 3)
+        XCTAssertTrue(outcome.rejected)
+    }
+    #endif
+    
 
 }
 